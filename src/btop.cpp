@@ -24,9 +24,12 @@ tab-size = 4
 #include <clocale>
 #include <filesystem>
 #include <iterator>
+#include <map>
 #include <mutex>
 #include <optional>
+#include <poll.h>
 #include <pthread.h>
+#include <sys/ioctl.h>
 #include <span>
 #include <string_view>
 #ifdef __FreeBSD__
@@ -66,7 +69,10 @@ tab-size = 4
 #include "btop_input.hpp"
 #include "btop_log.hpp"
 #include "btop_menu.hpp"
+#include "btop_metrics.hpp"
+#include "btop_screen.hpp"
 #include "btop_shared.hpp"
+#include "btop_stream.hpp"
 #include "btop_theme.hpp"
 #include "btop_tools.hpp"
 
@@ -224,6 +230,7 @@ void clean_quit(int sig) {
 		}
 	#endif
 	}
+	Metrics::stop();
 
 #ifdef GPU_SUPPORT
 	Gpu::Nvml::shutdown();
@@ -393,10 +400,7 @@ namespace Runner {
 	std::mutex mtx;
 
 	enum debug_actions {
-		collect_begin,
-		collect_done,
 		draw_begin,
-		draw_begin_only,
 		draw_done
 	};
 
@@ -408,6 +412,135 @@ namespace Runner {
 	string debug_bg;
 	std::unordered_map<string, array<uint64_t, 2>> debug_times;
 
+	//? Counters reported by collectors through debug_stat(), shown sorted by name below the timings
+	std::mutex debug_stats_mtx;
+	std::map<string, uint64_t> debug_stats;
+	size_t debug_stats_shown{};
+
+	void debug_stat(const string& name, uint64_t value) {
+		if (not Global::debug) return;
+		std::lock_guard lock {debug_stats_mtx};
+		debug_stats[name] = value;
+	}
+
+	//? Copy of the terminal contents used when screen_diff, adaptive_output or output_rate_limit is enabled,
+	//? only used by the runner thread or by run() while the runner is idle
+	Screen::Buffer screen;
+
+	//? Output pacing state for adaptive_output and output_rate_limit
+	bool frame_held{};
+	bool proc_skipped{};
+	int congested_updates{};
+	uint64_t frames_dropped{};
+	uint64_t output_rate{};
+	uint64_t output_wait{};
+	uint64_t rate_time{};
+	double rate_tokens{};
+	double adaptive_rate{};
+
+	//* Returns true if a runner frame should be held back, either because the terminal hasn't read the previous output yet
+	//* or because the output rate is over output_rate_limit or the rate adaptive_output has measured the terminal can handle
+	static bool output_congested() {
+		if (Config::getB("adaptive_output")) {
+		#ifdef TIOCOUTQ
+			int queued = 0;
+			if (ioctl(STDOUT_FILENO, TIOCOUTQ, &queued) == 0 and queued > 0) return true;
+		#endif
+			pollfd pfd { STDOUT_FILENO, POLLOUT, 0 };
+			if (poll(&pfd, 1, 0) == 0) return true;
+		}
+
+		//? Token bucket holding at most one second of output at the lower of the two rates
+		const double limit = Config::getI("output_rate_limit") * 1024.0;
+		const double rate = (adaptive_rate > 0 and (limit == 0 or adaptive_rate < limit)) ? adaptive_rate : limit;
+		const uint64_t now = time_micros();
+		rate_tokens = (rate > 0 ? min(rate, rate_tokens + (now - rate_time) * rate / 1'000'000) : 0);
+		rate_time = now;
+		return rate > 0 and rate_tokens <= 0;
+	}
+
+	//* Write <frame> to the terminal, only sending the changed cells if screen_diff is enabled.
+	//* <full> should be true if <frame> redraws the whole screen, diffing (re)starts from such frames.
+	//* Runner frames set <can_hold>, these are held back while output is congested and merged into the next frame that is sent.
+	//* Returns the number of bytes written.
+	static size_t write_frame(const string& frame, bool full, bool can_hold = false) {
+		const bool term_sync = Config::getB("terminal_sync");
+		const bool diff = Config::getB("screen_diff");
+		const bool adaptive = Config::getB("adaptive_output");
+		const bool pacing = adaptive or Config::getI("output_rate_limit") > 0;
+		const string* out = &frame;
+
+		if (diff or pacing) {
+			if (full) screen.reset(Term::width, Term::height);
+			if (screen.ready(Term::width, Term::height)) {
+				screen.write(frame);
+				if (can_hold and pacing and output_congested()) {
+					frame_held = true;
+					frames_dropped++;
+					return 0;
+				}
+				//? Frames are sent as generated unless diffing, or unless earlier frames were held back and only exist in the buffer
+				if (diff or frame_held) out = &screen.flush();
+				else screen.commit();
+				frame_held = false;
+			}
+		}
+		else screen.invalidate();
+
+		if (out->empty()) return 0;
+		const uint64_t start = time_micros();
+		cout << (term_sync ? Term::sync_start : "") << *out << (term_sync ? Term::sync_end : "") << flush;
+		output_wait = time_micros() - start;
+		rate_tokens -= out->size();
+
+		//? Writes only block when the terminal falls behind, output is then paced at half the rate it was drained at, or half the current pace.
+		//? The rate is raised for every write that doesn't block and the limit is lifted after 10 such writes.
+		if (output_wait > 20'000) {
+			output_rate = out->size() * 1'000'000 / output_wait;
+			if (adaptive) {
+				adaptive_rate = min<double>(output_rate, adaptive_rate > 0 ? adaptive_rate : output_rate) / 2;
+				congested_updates = 10;
+			}
+		}
+		else if (congested_updates > 0 and --congested_updates > 0) adaptive_rate += adaptive_rate / 8;
+		else adaptive_rate = 0;
+
+		return out->size();
+	}
+
+	uint64_t box_update_ms(const string& box) {
+		const int interval = Config::getI("update_ms_" + box);
+		return (interval > 0 ? interval : Config::getI("update_ms"));
+	}
+
+	static uint64_t tick_ms(const vector<string>& boxes) {
+		uint64_t tick = 0;
+		for (const auto& box : boxes) {
+			uint64_t interval = box_update_ms(box.starts_with("gpu") ? "gpu" : box);
+			if (box == "mem" and Config::getB("show_disks")) interval = min(interval, box_update_ms("disks"));
+			tick = (tick == 0 ? interval : min(tick, interval));
+		}
+		return (tick > 0 ? tick : Config::getI("update_ms"));
+	}
+
+	uint64_t tick_ms() {
+		return tick_ms(Config::current_boxes);
+	}
+
+	//? Workers for concurrent_collect, the runner thread collects one of the boxes itself so the pool holds one thread less than the number of boxes
+#ifdef GPU_SUPPORT
+	constexpr size_t collect_threads = 4;
+#else
+	constexpr size_t collect_threads = 3;
+#endif
+	Tools::ThreadPool collect_pool;
+
+	//? Last metrics_listen value the listener was started with, a failed start is only retried when the option changes
+	string metrics_listen;
+
+	//? Time in ms when each box is next due for collection, boxes that aren't due are skipped and keep their last drawn output on screen
+	std::unordered_map<string, uint64_t> next_due;
+
 	class MyNumPunct : public std::numpunct<char>
 	{
 	protected:
@@ -418,6 +551,8 @@ namespace Runner {
 
 	struct runner_conf {
 		vector<string> boxes;
+		//? Every shown box is drawn, not a single box updated from input
+		bool all_boxes;
 		bool no_update;
 		bool force_redraw;
 		bool background_update;
@@ -429,20 +564,8 @@ namespace Runner {
 
 	static void debug_timer(const char* name, const int action) {
 		switch (action) {
-			case collect_begin:
-				debug_times[name].at(collect) = time_micros();
-				return;
-			case collect_done:
-				debug_times[name].at(collect) = time_micros() - debug_times[name].at(collect);
-				debug_times["total"].at(collect) += debug_times[name].at(collect);
-				return;
-			case draw_begin_only:
-				debug_times[name].at(draw) = time_micros();
-				return;
 			case draw_begin:
 				debug_times[name].at(draw) = time_micros();
-				debug_times[name].at(collect) = debug_times[name].at(draw) - debug_times[name].at(collect);
-				debug_times["total"].at(collect) += debug_times[name].at(collect);
 				return;
 			case draw_done:
 				debug_times[name].at(draw) = time_micros() - debug_times[name].at(draw);
@@ -489,21 +612,25 @@ namespace Runner {
 
 			//! DEBUG stats
 			if (Global::debug) {
-                if (debug_bg.empty() or redraw)
-                    Runner::debug_bg = Draw::createBox(2, 2, 33,
-					#ifdef GPU_SUPPORT
-						9,
-					#else
-						8,
-					#endif
-					"", true, "μs");
-
+				//? Box is recreated when drawing the stats if cleared
+				if (redraw) debug_bg.clear();
 				debug_times.clear();
 				debug_times["total"] = {0, 0};
 			}
 
 			output.clear();
 
+			//? Input and redraws update every box, otherwise only boxes whose update time has passed are collected and drawn.
+			//? Half a tick of slack keeps a box from slipping a whole tick when the main loop wakes up slightly early.
+			const uint64_t now = time_ms(), slack = tick_ms(conf.boxes) / 2;
+			auto due = [&](const string& box) {
+				if (conf.no_update) return true;
+				auto& next = next_due[box];
+				if (not conf.force_redraw and now + slack < next) return false;
+				next = now + box_update_ms(box);
+				return true;
+			};
+
 			//* Run collection and draw functions for all boxes
 			try {
 #if defined(GPU_SUPPORT)
@@ -520,39 +647,137 @@ namespace Runner {
 					if (box.starts_with("gpu"))
 						gpu_panels.push_back(box.back()-'0');
 
+				//? Gpu info is still needed for the cpu box when gpus aren't due, the last collected values are used then
 				vector<Gpu::gpu_info> gpus;
-				if (gpu_in_cpu_panel or not gpu_panels.empty()) {
-					if (Global::debug) debug_timer("gpu", collect_begin);
-					gpus = Gpu::collect(conf.no_update);
-					if (Global::debug) debug_timer("gpu", collect_done);
-				}
-				auto& gpus_ref = gpus;
+				const bool gpu_collect = gpu_in_cpu_panel or not gpu_panels.empty();
+				const bool gpu_due = gpu_collect and due("gpu");
 #endif // GPU_SUPPORT
-
-				//? CPU
-				if (v_contains(conf.boxes, "cpu")) {
+				const bool cpu_due = v_contains(conf.boxes, "cpu") and due("cpu");
+				//? Disks are collected with mem but can have a longer update time
+				const bool mem_due = v_contains(conf.boxes, "mem") and due("mem");
+				Mem::collect_mem = mem_due;
+				Mem::collect_disks = v_contains(conf.boxes, "mem") and due("disks");
+				const bool net_due = v_contains(conf.boxes, "net") and due("net");
+				const bool proc_due = v_contains(conf.boxes, "proc") and due("proc");
+
+				//? Collectors can run at the same time, drawing starts when all are done since the cpu box also shows gpu data.
+				//? Cpu::collect() may raise Shared::coreCount when it finds new cores, so Proc::collect() gets a copy taken before collecting
+				const long core_count = Shared::coreCount;
+				Cpu::cpu_info* cpu{};
+				Mem::mem_info* mem{};
+				Net::net_info* net{};
+				vector<Proc::proc_info>* proc{};
+				vector<std::pair<string, std::function<void()>>> jobs;
+			#ifdef GPU_SUPPORT
+				if (gpu_collect) jobs.emplace_back("gpu", [&] {
+					try {
+						gpus = Gpu::collect(conf.no_update or not gpu_due);
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Gpu:: -> " + string{e.what()});
+					}
+				});
+			#endif
+				if (cpu_due) jobs.emplace_back("cpu", [&] {
 					try {
-						if (Global::debug) debug_timer("cpu", collect_begin);
+						cpu = &Cpu::collect(conf.no_update);
+						//? Redraw the box when the zoomed out history got a new step
+						if (not conf.no_update and not coreNum_reset and Cpu::update_history(*cpu)) Cpu::redraw = true;
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Cpu:: -> " + string{e.what()});
+					}
+				});
+				if (mem_due or Mem::collect_disks) jobs.emplace_back("mem", [&] {
+					try {
+						mem = &Mem::collect(conf.no_update);
+						if (not conf.no_update and mem_due and Mem::update_history(*mem)) Mem::redraw = true;
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Mem:: -> " + string{e.what()});
+					}
+				});
+				if (net_due) jobs.emplace_back("net", [&] {
+					try {
+						net = &Net::collect(conf.no_update);
+						if (not conf.no_update and Net::update_history(*net)) Net::redraw = true;
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Net:: -> " + string{e.what()});
+					}
+				});
+				if (proc_due) jobs.emplace_back("proc", [&] {
+					try {
+						proc = &Proc::collect(conf.no_update, core_count);
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Proc:: -> " + string{e.what()});
+					}
+				});
+
+				vector<uint64_t> collect_times(jobs.size());
+				auto collect_box = [&](size_t i) {
+					const uint64_t start = time_micros();
+					jobs[i].second();
+					collect_times[i] = time_micros() - start;
+				};
+				const uint64_t collect_start = time_micros();
+				if (Config::getB("concurrent_collect") and jobs.size() > 1) {
+					if (collect_pool.size() == 0) collect_pool.resize(collect_threads);
+					collect_pool.parallel_for(jobs.size(), collect_box);
+				}
+				else {
+					if (collect_pool.size() > 0) collect_pool.resize(0);
+					for (size_t i = 0; i < jobs.size(); i++) collect_box(i);
+				}
+
+				//? Per box collect times, the total is the time until all boxes were collected and the critical path the slowest box
+				if (Global::debug) {
+					uint64_t sum = 0, critical = 0;
+					for (size_t i = 0; i < jobs.size(); i++) {
+						debug_times[jobs[i].first].at(collect) = collect_times[i];
+						sum += collect_times[i];
+						critical = std::max(critical, collect_times[i]);
+					}
+					debug_times["total"].at(collect) = time_micros() - collect_start;
+					debug_stat("collect sum", sum);
+					debug_stat("collect critical", critical);
+				}
 
-						//? Start collect
-						auto cpu = Cpu::collect(conf.no_update);
+				if (coreNum_reset) {
+					coreNum_reset = false;
+					Cpu::core_mapping = Cpu::get_core_mapping();
+					Global::resized = true;
+					Input::interrupt();
+					continue;
+				}
 
-						if (coreNum_reset) {
-							coreNum_reset = false;
-							Cpu::core_mapping = Cpu::get_core_mapping();
-							Global::resized = true;
-							Input::interrupt();
-							continue;
-						}
+				//? Metrics export, boxes that weren't collected keep their last values in the snapshot
+				if (const auto& listen = Config::getS("metrics_listen"); listen != metrics_listen) {
+					metrics_listen = listen;
+					Metrics::start(listen);
+				}
+				if (not conf.no_update and not Metrics::listening().empty()) {
+					Metrics::update(
+						cpu, mem, net != nullptr ? &Net::current_net : nullptr,
+					#ifdef GPU_SUPPORT
+						gpu_due ? &gpus : nullptr,
+					#endif
+						proc
+					);
+				}
 
+				//? CPU
+				if (cpu != nullptr) {
+					try {
 						if (Global::debug) debug_timer("cpu", draw_begin);
 
 						//? Draw box
 						if (not pause_output) {
 							output += Cpu::draw(
-								cpu,
+								*cpu,
 #if defined(GPU_SUPPORT)
-								gpus_ref,
+								gpus,
 #endif // GPU_SUPPORT
 								conf.force_redraw,
 								conf.no_update
@@ -567,14 +792,14 @@ namespace Runner {
 				}
 			#ifdef GPU_SUPPORT
 				//? GPU
-				if (not gpu_panels.empty() and not gpus_ref.empty()) {
+				if (not gpu_panels.empty() and not gpus.empty() and gpu_due) {
 					try {
-						if (Global::debug) debug_timer("gpu", draw_begin_only);
+						if (Global::debug) debug_timer("gpu", draw_begin);
 
 						//? Draw box
 						if (not pause_output)
 							for (unsigned long i = 0; i < gpu_panels.size(); ++i)
-								output += Gpu::draw(gpus_ref[gpu_panels[i]], i, conf.force_redraw, conf.no_update);
+								output += Gpu::draw(gpus[gpu_panels[i]], i, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("gpu", draw_done);
 					}
@@ -584,17 +809,12 @@ namespace Runner {
 				}
 			#endif
 				//? MEM
-				if (v_contains(conf.boxes, "mem")) {
+				if (mem != nullptr) {
 					try {
-						if (Global::debug) debug_timer("mem", collect_begin);
-
-						//? Start collect
-						auto mem = Mem::collect(conf.no_update);
-
 						if (Global::debug) debug_timer("mem", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Mem::draw(mem, conf.force_redraw, conf.no_update);
+						if (not pause_output) output += Mem::draw(*mem, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("mem", draw_done);
 					}
@@ -604,17 +824,12 @@ namespace Runner {
 				}
 
 				//? NET
-				if (v_contains(conf.boxes, "net")) {
+				if (net != nullptr) {
 					try {
-						if (Global::debug) debug_timer("net", collect_begin);
-
-						//? Start collect
-						auto net = Net::collect(conf.no_update);
-
 						if (Global::debug) debug_timer("net", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Net::draw(net, conf.force_redraw, conf.no_update);
+						if (not pause_output) output += Net::draw(*net, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("net", draw_done);
 					}
@@ -624,17 +839,18 @@ namespace Runner {
 				}
 
 				//? PROC
-				if (v_contains(conf.boxes, "proc")) {
+				if (proc != nullptr) {
 					try {
-						if (Global::debug) debug_timer("proc", collect_begin);
-
-						//? Start collect
-						auto proc = Proc::collect(conf.no_update);
-
 						if (Global::debug) debug_timer("proc", draw_begin);
 
-						//? Draw box
-						if (not pause_output) output += Proc::draw(proc, conf.force_redraw, conf.no_update);
+						//? Draw box, every other update while output is congested unless redrawing or responding to input
+						if (not pause_output) {
+							if (congested_updates == 0 or conf.force_redraw or conf.no_update or proc_skipped) {
+								output += Proc::draw(*proc, conf.force_redraw, conf.no_update);
+								proc_skipped = false;
+							}
+							else proc_skipped = true;
+						}
 
 						if (Global::debug) debug_timer("proc", draw_done);
 					}
@@ -655,6 +871,9 @@ namespace Runner {
 				continue;
 			}
 
+			//? Boxes are skipped while paused and single box runs only draw their own box,
+			//? so only a redraw of all boxes without pause contains the whole screen
+			const bool full_frame = (redraw or conf.force_redraw) and conf.all_boxes and not pause_output;
 			if (redraw or conf.force_redraw) {
 				empty_bg.clear();
 				redraw = false;
@@ -693,6 +912,17 @@ namespace Runner {
 
 			//! DEBUG stats -->
 			if (Global::debug and not Menu::active) {
+				std::lock_guard stats_lock {debug_stats_mtx};
+				if (debug_bg.empty() or debug_stats_shown != debug_stats.size()) {
+					debug_stats_shown = debug_stats.size();
+					Runner::debug_bg = Draw::createBox(2, 2, 33,
+					#ifdef GPU_SUPPORT
+						9 + debug_stats_shown,
+					#else
+						8 + debug_stats_shown,
+					#endif
+						"", true, "μs");
+				}
 				output += fmt::format("{pre}{box:5.5} {collect:>12.12} {draw:>12.12}{post}",
 					"pre"_a = debug_bg + Theme::c("title") + Fx::b,
 					"box"_a = "box", "collect"_a = "collect", "draw"_a = "draw",
@@ -714,14 +944,28 @@ namespace Runner {
 						"draw"_a = time_draw
 					);
 				}
+				output += Fx::ub;
+				for (const auto& [name, value] : debug_stats) {
+					output += fmt::format(loc, "{mvLD}{name:18.18} {value:12L}",
+						"mvLD"_a = Mv::l(31) + Mv::d(1),
+						"name"_a = name,
+						"value"_a = value
+					);
+				}
 			}
 
 			//? If overlay isn't empty, print output without color and then print overlay on top
-			const bool term_sync = Config::getB("terminal_sync");
-			cout << (term_sync ? Term::sync_start : "") << (conf.overlay.empty()
-					? output
-					: (output.empty() ? "" : Fx::ub + Theme::c("inactive_fg") + Fx::uncolor(output)) + conf.overlay)
-				<< (term_sync ? Term::sync_end : "") << flush;
+			if (not conf.overlay.empty())
+				output = (output.empty() ? "" : Fx::ub + Theme::c("inactive_fg") + Fx::uncolor(output)) + conf.overlay;
+			//? Only timer frames are held back, frames answering input or a redraw are sent at once together with any held output
+			const size_t bytes_sent = write_frame(output, full_frame, not conf.no_update and not conf.force_redraw);
+
+			//? Shown in the debug box on the next update
+			debug_stat("frame bytes", output.size());
+			debug_stat("frame bytes sent", bytes_sent);
+			debug_stat("frames dropped", frames_dropped);
+			debug_stat("output B/s", output_rate);
+			debug_stat("output wait", output_wait);
 		}
 		//* ----------------------------------------------- THREAD LOOP -----------------------------------------------
 		return {};
@@ -742,12 +986,10 @@ namespace Runner {
 		if (stopping or Global::resized) return;
 
 		if (box == "overlay") {
-			const bool term_sync = Config::getB("terminal_sync");
-			cout << (term_sync ? Term::sync_start : "") << Global::overlay << (term_sync ? Term::sync_end : "") << flush;
+			write_frame(Global::overlay, false);
 		}
 		else if (box == "clock") {
-			const bool term_sync = Config::getB("terminal_sync");
-			cout << (term_sync ? Term::sync_start : "") << Global::clock << (term_sync ? Term::sync_end : "") << flush;
+			write_frame(Global::clock, false);
 		}
 		else {
 			Config::unlock();
@@ -755,6 +997,7 @@ namespace Runner {
 
 			current_conf = {
 				(box == "all" ? Config::current_boxes : vector{box}),
+				box == "all",
 				no_update, force_redraw,
 				(not Config::getB("tty_mode") and Config::getB("background_update")),
 				Global::overlay,
@@ -934,6 +1177,12 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	//? Config init
 	init_config(cli.low_color, cli.filter);
 
+	//? Headless mode, runs the collectors and writes samples to stdout without a terminal or any drawing
+	if (cli.stream.has_value()) {
+		const auto interval = cli.updates.has_value() ? cli.updates.value() : Config::getI("update_ms");
+		return Stream::run(cli.stream.value() == "csv" ? Stream::Format::csv : Stream::Format::json, interval, cli.stream_procs.value_or(10));
+	}
+
 	//? Try to find and set a UTF-8 locale
 	if (std::setlocale(LC_ALL, "") != nullptr and not std::string_view { std::setlocale(LC_ALL, "") }.contains(";")
 	and str_to_upper(s_replace((string)std::setlocale(LC_ALL, ""), "-", "")).ends_with("UTF8")) {
@@ -1103,7 +1352,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	if (cli.updates.has_value()) {
 		Config::set("update_ms", static_cast<int>(cli.updates.value()));
 	}
-	uint64_t update_ms = Config::getI("update_ms");
+	uint64_t update_ms = Runner::tick_ms();
 	auto future_time = time_ms();
 
 	try {
@@ -1149,10 +1398,10 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 				Runner::run("clock");
 			}
 
-			//? Start secondary collect & draw thread at the interval set by <update_ms> config value
+			//? Start secondary collect & draw thread at the interval set by <update_ms> or the shortest update_ms_<box> config value
 			if (time_ms() >= future_time and not Global::resized) {
 				Runner::run("all");
-				update_ms = Config::getI("update_ms");
+				update_ms = Runner::tick_ms();
 				future_time = time_ms() + update_ms;
 			}
 
@@ -1160,8 +1409,8 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 			for (auto current_time = time_ms(); current_time < future_time; current_time = time_ms()) {
 
 				//? Check for external clock changes and for changes to the update timer
-				if (std::cmp_not_equal(update_ms, Config::getI("update_ms"))) {
-					update_ms = Config::getI("update_ms");
+				if (update_ms != Runner::tick_ms()) {
+					update_ms = Runner::tick_ms();
 					future_time = time_ms() + update_ms;
 				}
 				else if (future_time - current_time > update_ms) {
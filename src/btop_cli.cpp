@@ -153,6 +153,41 @@ namespace Cli {
 				}
 				continue;
 			}
+			if (arg == "--stream") {
+				// This flag requires an argument.
+				if (++it == args.end()) {
+					error("Stream requires an argument");
+					return std::unexpected { 1 };
+				}
+
+				auto arg = *it;
+				if (arg != "json" && arg != "csv") {
+					error("Stream format must be 'json' or 'csv'");
+					return std::unexpected { 1 };
+				}
+				cli.stream = std::make_optional(std::string { arg });
+				continue;
+			}
+			if (arg == "--stream-procs") {
+				// This flag requires an argument.
+				if (++it == args.end()) {
+					error("Stream procs requires an argument");
+					return std::unexpected { 1 };
+				}
+
+				auto arg = *it;
+				try {
+					auto procs = std::clamp(std::stoi(arg.data()), 0, 1000);
+					cli.stream_procs = std::make_optional(procs);
+				} catch (std::invalid_argument& e) {
+					error("Stream procs must be a positive number");
+					return std::unexpected { 1 };
+				} catch (std::out_of_range& e) {
+					error(fmt::format("Stream procs argument is out of range: {}", arg.data()));
+					return std::unexpected { 1 };
+				}
+				continue;
+			}
 			if (arg == "--themes-dir") {
 				// This flag requires an argument.
 				if (++it == args.end()) {
@@ -255,6 +290,9 @@ namespace Cli {
 			"  {2}    --force-utf{1}         Override automatic UTF locale detection\n"
 			"  {2}-l, --low-color{1}         Disable true color, 256 colors only\n"
 			"  {2}-p, --preset{1} <id>       Start with a preset (0-9)\n"
+			"  {2}    --stream{1} <format>   Write samples to standard output as json lines or csv instead of\n"
+			"                          starting the interface, one sample per update (see --update)\n"
+			"  {2}    --stream-procs{1} <n>  Number of processes in streamed samples (default 10)\n"
 			"  {2}-t, --tty{1}               Force tty mode with ANSI graph symbols and 16 colors only\n"
 			"  {2}    --themes-dir{1} <dir>  Path to a custom themes directory\n"
 			"  {2}    --no-tty{1}            Force disable tty mode\n"
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <optional>
 #include <span>
+#include <string>
 #include <string_view>
 
 namespace Cli {
@@ -28,6 +29,10 @@ namespace Cli {
 		bool low_color {};
 		// Start with one of the provided presets
 		std::optional<std::uint32_t> preset;
+		// Write samples to standard output in this format ("json" or "csv") instead of starting the interface
+		std::optional<std::string> stream;
+		// Number of processes included in streamed samples
+		std::optional<std::uint32_t> stream_procs;
 		// Path to a custom themes directory
 		std::optional<stdfs::path> themes_dir;
 		// The initial refresh rate
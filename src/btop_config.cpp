@@ -63,6 +63,8 @@ const vector<string> Config::freq_modes = { "first", "range", "lowest", "highest
 const vector<string> Config::show_gpu_values = { "Auto", "On", "Off" };
 #endif
 const vector<string> Config::base_10_bitrate_values = { "Auto", "True", "False" };
+const vector<string> Config::history_zoom_values = { "Live", "10s", "1m", "10m" };
+const vector<string> Config::history_consolidations = { "avg", "min", "max" };
 const vector<string> Config::disable_preset_options = { "Off", "Default", "Custom", "All" };
 
 //* Functions and variables for reading and writing the btop config file
@@ -102,6 +104,15 @@ namespace Config {
 
 		{"terminal_sync", 		"#* Use terminal synchronized output sequences to reduce flickering on supported terminals."},
 
+		{"screen_diff", 		"#* Keep a copy of the screen and only send the parts that changed since the last update.\n"
+								"#* Reduces the amount of data sent each update, useful over ssh on slow connections. Uses some extra cpu and memory."},
+
+		{"adaptive_output", 	"#* Hold back updates while the terminal can't keep up with the output, e.g. over a slow ssh connection.\n"
+								"#* Held back updates are merged into the next one sent and the process box is updated less often until output catches up."},
+
+		{"output_rate_limit", 	"#* Limit the rate of output to the terminal in KiB per second, updates over the limit are held back as with adaptive_output.\n"
+								"#* 0 to disable."},
+
 		{"graph_symbol", 		"#* Default symbols to use for graph creation, \"braille\", \"block\" or \"tty\".\n"
 								"#* \"braille\" offers the highest resolution but might not be included in all fonts.\n"
 								"#* \"block\" has half the resolution of braille but uses more common characters.\n"
@@ -122,6 +133,31 @@ namespace Config {
 
 		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
 
+		{"update_ms_cpu", 		"#* Update times in milliseconds for each box, to update expensive boxes like proc and disks less often than the rest.\n"
+								"#* 0 to use update_ms. The shortest update time of the shown boxes sets how often btop wakes up."},
+
+		{"update_ms_mem", ""},
+
+		{"update_ms_disks", ""},
+
+		{"update_ms_net", ""},
+
+		{"update_ms_proc", ""},
+
+		{"update_ms_gpu", ""},
+
+		{"concurrent_collect",	"#* Collect the data for each box at the same time on separate threads, boxes are still drawn one after another.\n"
+								"#* Lowers the time from the start of an update to the drawn frame when a single box, like proc or gpu, is slow to collect."},
+
+		{"metrics_listen",		"#* Serve the values of the shown boxes in Prometheus text format, as an absolute unix socket path or a tcp port on 127.0.0.1.\n"
+								"#* E.g. \"/run/user/1000/btop.sock\" to scrape with \"curl --unix-socket /run/user/1000/btop.sock http://localhost/metrics\". Empty to disable."},
+
+		{"history_zoom",		"#* Time per step for the cpu, mem and net graphs, \"Live\" shows every sample, \"10s\", \"1m\" and \"10m\" zoom out to\n"
+								"#* a long term history of up to 512 steps that is recorded in the background. Steps without samples are left blank.\n"
+								"#* Only the cpu graphs for total and cpu time fields, the mem graphs and the net graphs zoom, core and gpu graphs always show live samples."},
+
+		{"history_consolidation", "#* Value shown for each step of a zoomed out graph, \"avg\", \"min\" or \"max\" of the samples in the step."},
+
 		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
 								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
 
@@ -145,6 +181,16 @@ namespace Config {
 
 		{"proc_filter_kernel",  "#* (Linux) Filter processes tied to the Linux kernel(similar behavior to htop)."},
 
+		{"proc_collect_threads", "#* (Linux) Number of threads used to read process information, 1 to disable parallel collection.\n"
+								 "#* 0 to scale with number of processes and cpu cores (one thread per 512 processes)."},
+
+		{"proc_lazy_cmdline",	"#* (Linux) Only read the command line of processes when shown, filtered or sorted by command."},
+
+		{"proc_events",			"#* (Linux) Track process start and exit with kernel proc connector events instead of scanning /proc every update.\n"
+								"#* Requires CAP_NET_ADMIN (running as root), falls back to scanning /proc if not available."},
+
+		{"proc_io_uring",		"#* (Linux) Read process stat files in batches with io_uring, falls back to plain reads if io_uring is not available."},
+
 		{"proc_follow_detailed",	"#* Should the process list follow the selected process when detailed view is open."},
 
 		{"proc_aggregate",		"#* In tree-view, always accumulate child process resources in the parent process."},
@@ -206,6 +252,10 @@ namespace Config {
 		{"mem_below_net",		"#* Show mem box below net box instead of above."},
 
 		{"zfs_arc_cached",		"#* Count ZFS ARC in cached and available memory."},
+	#ifdef __linux__
+		{"mem_extended_fields",	"#* Extra memory fields to show as meters below the memory values, separate multiple values with whitespace \" \".\n"
+								"#* Available values: \"dirty\", \"writeback\", \"shmem\", \"slab\", \"hugepages\" and \"committed\". Example: \"dirty writeback committed\""},
+	#endif
 
 		{"show_swap", 			"#* If swap memory should be shown in memory box."},
 
@@ -223,6 +273,11 @@ namespace Config {
 
 		{"show_io_stat", 		"#* Toggles if io activity % (disk busy time) should be shown in regular disk usage view."},
 
+	#ifdef __linux__
+		{"show_io_latency", 	"#* Show graphs of the average time per io request (await, 100 ms at the top) and the average number of requests in flight\n"
+								"#* (queue depth, 32 at the top) for each disk. Linux only."},
+	#endif
+
 		{"io_mode", 			"#* Toggles io mode for disks, showing big graphs for disk read/write speeds."},
 
 		{"io_graph_combined", 	"#* Set to True to show combined read/write io graphs in io mode."},
@@ -288,6 +343,8 @@ namespace Config {
 		{"selected_battery", "Auto"},
 		{"cpu_core_map", ""},
 		{"temp_scale", "celsius"},
+		{"history_zoom", "Live"},
+		{"history_consolidation", "avg"},
 	#ifdef __linux__
 		{"freq_mode", "first"},
 	#endif
@@ -295,9 +352,13 @@ namespace Config {
 		{"custom_cpu_name", ""},
 		{"disks_filter", ""},
 		{"io_graph_speeds", ""},
+	#ifdef __linux__
+		{"mem_extended_fields", ""},
+	#endif
 		{"net_iface", ""},
 		{"base_10_bitrate", "Auto"},
 		{"log_level", "WARNING"},
+		{"metrics_listen", ""},
 		{"proc_filter", ""},
 		{"proc_command", ""},
 		{"selected_name", ""},
@@ -328,6 +389,9 @@ namespace Config {
 		{"proc_info_smaps", false},
 		{"proc_left", false},
 		{"proc_filter_kernel", false},
+		{"proc_lazy_cmdline", false},
+		{"proc_events", false},
+		{"proc_io_uring", false},
 		{"cpu_invert_lower", true},
 		{"cpu_single_graph", false},
 		{"cpu_bottom", false},
@@ -347,6 +411,9 @@ namespace Config {
 		{"use_fstab", true},
 		{"zfs_hide_datasets", false},
 		{"show_io_stat", true},
+	#ifdef __linux__
+		{"show_io_latency", false},
+	#endif
 		{"io_mode", false},
 		{"swap_upload_download", false},
 		{"base_10_sizes", false},
@@ -376,6 +443,9 @@ namespace Config {
 		{"gpu_mirror_graph", true},
 	#endif
 		{"terminal_sync", true},
+		{"screen_diff", false},
+		{"adaptive_output", false},
+		{"concurrent_collect", false},
 		{"save_config_on_exit", true},
 		{"disable_mouse", false},
 	};
@@ -383,9 +453,17 @@ namespace Config {
 
 	std::unordered_map<std::string_view, int> ints = {
 		{"update_ms", 2000},
+		{"update_ms_cpu", 0},
+		{"update_ms_mem", 0},
+		{"update_ms_disks", 0},
+		{"update_ms_net", 0},
+		{"update_ms_proc", 0},
+		{"update_ms_gpu", 0},
 		{"net_download", 100},
 		{"net_upload", 100},
 		{"proc_tree_auto_collapse", 0},
+		{"proc_collect_threads", 0},
+		{"output_rate_limit", 0},
 		{"detailed_pid", 0},
 		{"restore_detailed_pid", 0},
 		{"selected_pid", 0},
@@ -580,12 +658,27 @@ namespace Config {
 		else if (name == "update_ms" and i_value > ONE_DAY_MILLIS)
 			validError = fmt::format("Config value update_ms set too high (>{}).", ONE_DAY_MILLIS);
 
+		else if (name.starts_with("update_ms_") and i_value != 0 and (i_value < 100 or i_value > ONE_DAY_MILLIS))
+			validError = fmt::format("Config value {} must be 0 or between 100 and {}.", name, ONE_DAY_MILLIS);
+
 		else if (name == "proc_tree_auto_collapse" and i_value < 0)
 			validError = "Config value proc_tree_auto_collapse must be >= 0.";
 
 		else if (name == "proc_tree_auto_collapse" and i_value > 10000)
 			validError = "Config value proc_tree_auto_collapse set too high (>10000).";
 
+		else if (name == "output_rate_limit" and i_value < 0)
+			validError = "Config value output_rate_limit must be >= 0.";
+
+		else if (name == "output_rate_limit" and i_value > 1'000'000)
+			validError = "Config value output_rate_limit set too high (>1000000).";
+
+		else if (name == "proc_collect_threads" and i_value < 0)
+			validError = "Config value proc_collect_threads must be >= 0.";
+
+		else if (name == "proc_collect_threads" and i_value > 256)
+			validError = "Config value proc_collect_threads set too high (>256).";
+
 		else
 			return true;
 
@@ -607,6 +700,16 @@ namespace Config {
 		else if (name.starts_with("graph_symbol_") and (value != "default" and not v_contains(valid_graph_symbols, value)))
 			validError = fmt::format("Invalid graph symbol identifier for {}: {}", name, value);
 
+		else if (name == "metrics_listen" and not value.empty() and not value.starts_with('/')
+			and (not isint(value) or value.size() > 5 or stoi(value) < 1 or stoi(value) > 65535))
+			validError = "Invalid metrics_listen, must be an absolute socket path or a port number: " + value;
+
+		else if (name == "history_zoom" and not v_contains(history_zoom_values, value))
+			validError = "Invalid history_zoom: " + value;
+
+		else if (name == "history_consolidation" and not v_contains(history_consolidations, value))
+			validError = "Invalid history_consolidation: " + value;
+
 		else if (name == "shown_boxes" and not Global::init_conf) {
 			if (value.empty())
 				validError = "No boxes selected!";
@@ -660,6 +763,15 @@ namespace Config {
 			}
 			return true;
 		}
+		else if (name == "mem_extended_fields") {
+			for (const auto& field : ssplit(value)) {
+				if (std::ranges::find(Mem::extended_names, field) == Mem::extended_names.end()) {
+					validError = "Invalid mem_extended_fields value: " + field;
+					return false;
+				}
+			}
+			return true;
+		}
 
 		else
 			return true;
@@ -53,6 +53,8 @@ namespace Config {
 	extern const  vector<string> show_gpu_values;
 #endif
     extern const vector<string> base_10_bitrate_values;
+	extern const vector<string> history_zoom_values;
+	extern const vector<string> history_consolidations;
 	extern vector<string> current_boxes;
 	extern vector<string> preset_list;
 	extern const vector<string> disable_preset_options;
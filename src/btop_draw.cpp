@@ -419,70 +419,81 @@ namespace Draw {
 	}
 
 	//* Graph class ------------------------------------------------------------------------------------------------------------>
-	void Graph::_create(const deque<long long>& data, int data_offset) {
+	template <typename T>
+	void Graph::_create(const RingBuffer<T>& data, int data_offset) {
+		//? Gaps in a zoomed out history are passed on as -1 and drawn blank, live data can't hold gaps and may reach the gap value
+		const auto scale = [&](T value) -> long long {
+			if (gaps and value == history_gap<T>) return -1;
+			return (max_value > 0 ? clamp((value + offset) * 100 / max_value, 0ll, 100ll) : value);
+		};
 		bool mult = (data.size() - data_offset > 1);
-		const auto& graph_symbol = Symbols::graph_symbols.at(symbol + '_' + (invert ? "down" : "up"));
-		array<int, 2> result;
-		const float mod = (height == 1) ? 0.3 : 0.1;
 		long long data_value = 0;
-		if (mult and data_offset > 0) {
-			last = data.at(data_offset - 1);
-			if (max_value > 0) last = clamp((last + offset) * 100 / max_value, 0ll, 100ll);
-		}
+		if (mult and data_offset > 0) last = scale(data[data_offset - 1]);
 
 		//? Horizontal iteration over values in <data>
 		for (const int& i : iota(data_offset, (int)data.size())) {
-			// if (tty_mode and mult and i % 2 != 0) continue;
 			if (not tty_mode and mult) current = not current;
 			if (i < 0) {
 				data_value = 0;
 				last = 0;
 			}
-			else {
-				data_value = data.at(i);
-				if (max_value > 0) data_value = clamp((data_value + offset) * 100 / max_value, 0ll, 100ll);
-			}
-
-			//? Vertical iteration over height of graph
-			for (const int& horizon : iota(0, height)) {
-				const int cur_high = (height > 1) ? round(100.0 * (height - horizon) / height) : 100;
-				const int cur_low = (height > 1) ? round(100.0 * (height - (horizon + 1)) / height) : 0;
-				//? Calculate previous + current value to fit two values in 1 braille character
-				for (int ai = 0; const auto& value : {last, data_value}) {
-					const int clamp_min = (no_zero and horizon == height - 1 and not (mult and i == data_offset and ai == 0)) ? 1 : 0;
-					if (value >= cur_high)
-						result[ai++] = 4;
-					else if (value <= cur_low)
-						result[ai++] = clamp_min;
-					else {
-						result[ai++] = clamp((int)round((float)(value - cur_low) * 4 / (cur_high - cur_low) + mod), clamp_min, 4);
-					}
-				}
-				//? Generate graph symbol from 5x5 2D vector
-				if (height == 1) {
-					if (result.at(0) + result.at(1) == 0) graphs.at(current).at(horizon) += Mv::r(1);
-					else {
-						if (not color_gradient.empty()) graphs.at(current).at(horizon) += Theme::g(color_gradient).at(clamp(max(last, data_value), 0ll, 100ll));
-						graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
-					}
-				}
-				else graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
-			}
+			else data_value = scale(data[i]);
+			_push(last, data_value, mult and i == data_offset);
 			if (mult and i >= 0) last = data_value;
 		}
 		last = data_value;
+		_render();
+	}
+
+	void Graph::_push(long long prev, long long value, bool first) {
+		const auto& graph_symbol = *glyphs;
+		auto& sizes = cell_sizes[current];
+		int& col = head[current];
+		const auto prev_level = static_cast<size_t>(clamp(prev, 0ll, 100ll));
+		const auto value_level = static_cast<size_t>(clamp(value, 0ll, 100ll));
+
+		for (int row = 0; row < height; row++) {
+			//? Drop the bytes of the oldest column, the buffer is compacted once the dropped part is larger than the rest
+			auto& buffer = rows[current][row];
+			auto& size = sizes[row * width + col];
+			buffer.start += size;
+			if (buffer.start > buffer.bytes.size() / 2) {
+				buffer.bytes.erase(0, buffer.start);
+				buffer.start = 0;
+			}
+
+			//? Keep at least one dot on the bottom row if no_zero is set, except for the value before the first column and gaps
+			const uint8_t min_level = (no_zero and row == height - 1) ? 1 : 0;
+			const uint8_t prev_dots = (prev < 0 ? 0 : max(levels[row][prev_level], first ? uint8_t{} : min_level));
+			const uint8_t value_dots = (value < 0 ? 0 : max(levels[row][value_level], min_level));
+			const uint8_t glyph = prev_dots * 5 + value_dots;
+
+			const size_t before = buffer.bytes.size();
+			if (height > 1) buffer.bytes += graph_symbol[glyph];
+			else if (glyph == 0) buffer.bytes += skip;
+			else {
+				if (not color_gradient.empty()) buffer.bytes += Theme::g(color_gradient).at(max(prev_level, value_level));
+				buffer.bytes += graph_symbol[glyph];
+			}
+			size = buffer.bytes.size() - before;
+		}
+		col = (col + 1) % width;
+	}
+
+	void Graph::_render() {
 		out.clear();
 		if (height == 1) {
-			//if (not color_gradient.empty())
-			//	out += (last < 1 ? Theme::c("inactive_fg") : Theme::g(color_gradient).at(clamp(last, 0ll, 100ll)));
-			out += graphs.at(current).at(0);
+			const auto& buffer = rows[current][0];
+			out.append(buffer.bytes, buffer.start);
 		}
 		else {
+			const string line_break = Mv::d(1) + Mv::l(width);
 			for (const int& i : iota(1, height + 1)) {
-				if (i > 1) out += Mv::d(1) + Mv::l(width);
+				if (i > 1) out += line_break;
 				if (not color_gradient.empty())
 					out += (invert) ? Theme::g(color_gradient).at(i * 100 / height) : Theme::g(color_gradient).at(100 - ((i - 1) * 100 / height));
-				out += (invert) ? graphs.at(current).at(height - i) : graphs.at(current).at(i-1);
+				const auto& buffer = rows[current][(invert) ? height - i : i - 1];
+				out.append(buffer.bytes, buffer.start);
 			}
 		}
 		if (not color_gradient.empty()) out += Fx::reset;
@@ -490,11 +501,12 @@ namespace Draw {
 
 	Graph::Graph() {}
 
+	template <typename T>
 	Graph::Graph(int width, int height, const string& color_gradient,
-				 const deque<long long>& data, const string& symbol,
-				 bool invert, bool no_zero, long long max_value, long long offset)
+				 const RingBuffer<T>& data, const string& symbol,
+				 bool invert, bool no_zero, long long max_value, long long offset, bool gaps)
 	: width(width), height(height), color_gradient(color_gradient),
-	  invert(invert), no_zero(no_zero), offset(offset) {
+	  invert(invert), no_zero(no_zero), gaps(gaps), offset(offset) {
 		if (Config::getB("tty_mode") or symbol == "tty") this->symbol = "tty";
 		else if (symbol != "default") this->symbol = symbol;
 		else this->symbol = Config::getS("graph_symbol");
@@ -502,6 +514,10 @@ namespace Draw {
 
 		if (max_value == 0 and offset > 0) max_value = 100;
 		this->max_value = max_value;
+		if (width <= 0 or height <= 0) {
+			this->width = this->height = 0;
+			return;
+		}
 		const int value_width = (tty_mode ? data.size() : ceil((double)data.size() / 2));
 		int data_offset = (value_width > width) ? data.size() - width * (tty_mode ? 1 : 2) : 0;
 
@@ -509,28 +525,39 @@ namespace Draw {
 			data_offset--;
 		}
 
-		//? Populate the two switching graph vectors and fill empty space if data size < width
-		for (const int& i : iota(0, height * 2)) {
-			if (tty_mode and i % 2 != current) continue;
-			graphs[(i % 2 != 0)].push_back((value_width < width) ? ((height == 1) ? Mv::r(1) : " "s) * (width - value_width) : "");
+		//? Precompute the dots filled by every value from 0 to 100 for each row, two values share one character
+		const float mod = (height == 1) ? 0.3 : 0.1;
+		levels.resize(height);
+		for (int row = 0; row < height; row++) {
+			const int cur_high = (height > 1) ? round(100.0 * (height - row) / height) : 100;
+			const int cur_low = (height > 1) ? round(100.0 * (height - (row + 1)) / height) : 0;
+			for (int value = 0; value <= 100; value++) {
+				if (value >= cur_high) levels[row][value] = 4;
+				else if (value <= cur_low) levels[row][value] = 0;
+				else levels[row][value] = clamp((int)round((float)(value - cur_low) * 4 / (cur_high - cur_low) + mod), 0, 4);
+			}
+		}
+
+		glyphs = &Symbols::graph_symbols.at(this->symbol + '_' + (invert ? "down" : "up"));
+		skip = Mv::r(1);
+
+		//? Empty cells fill the space to the left if data size < width
+		const string& empty = (height == 1) ? skip : glyphs->at(0);
+		for (const int set : {0, 1}) {
+			if (tty_mode and set != current) continue;
+			rows[set].assign(height, { empty * width, 0 });
+			cell_sizes[set].assign(width * height, empty.size());
 		}
 		if (data.size() == 0) return;
 		this->_create(data, data_offset);
 	}
 
-	string& Graph::operator()(const deque<long long>& data, bool data_same) {
-		if (data_same) return out;
+	template <typename T>
+	string& Graph::operator()(const RingBuffer<T>& data, bool data_same) {
+		if (data_same or width == 0) return out;
 
 		//? Make room for new characters on graph
 		if (not tty_mode) current = not current;
-		for (const int& i : iota(0, height)) {
-			if (height == 1 and graphs.at(current).at(i).at(1) == '[') {
-				if (graphs.at(current).at(i).at(3) == 'C') graphs.at(current).at(i).erase(0, 4);
-				else graphs.at(current).at(i).erase(0, graphs.at(current).at(i).find_first_of('m') + 4);
-			}
-			else if (graphs.at(current).at(i).at(0) == ' ') graphs.at(current).at(i).erase(0, 1);
-			else graphs.at(current).at(i).erase(0, 3);
-		}
 		this->_create(data, (int)data.size() - 1);
 		return out;
 	}
@@ -538,6 +565,14 @@ namespace Draw {
 	string& Graph::operator()() {
 		return out;
 	}
+
+	//? Graphs are drawn from percentage histories stored as uint8_t, temperatures as int16_t and byte rates as long long
+	template Graph::Graph(int, int, const string&, const RingBuffer<uint8_t>&, const string&, bool, bool, long long, long long, bool);
+	template Graph::Graph(int, int, const string&, const RingBuffer<int16_t>&, const string&, bool, bool, long long, long long, bool);
+	template Graph::Graph(int, int, const string&, const RingBuffer<long long>&, const string&, bool, bool, long long, long long, bool);
+	template string& Graph::operator()(const RingBuffer<uint8_t>&, bool);
+	template string& Graph::operator()(const RingBuffer<int16_t>&, bool);
+	template string& Graph::operator()(const RingBuffer<long long>&, bool);
 	//*------------------------------------------------------------------------------------------------------------------------->
 
 }
@@ -601,6 +636,8 @@ namespace Cpu {
 		auto& graph_bg = Symbols::graph_symbols.at((graph_symbol == "default" ? Config::getS("graph_symbol") + "_up" : graph_symbol + "_up")).at(6);
 		auto& temp_scale = Config::getS("temp_scale");
 		auto cpu_bottom = Config::getB("cpu_bottom");
+		//? Zoomed out graphs are recreated from the history when the runner sets redraw
+		const bool zoomed = Shared::history_tier() >= 0;
 		const auto safe_cpu_temp_max = cpu.temp_max <= 0 ? 90 : cpu.temp_max;
 
 		const string& title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
@@ -686,7 +723,7 @@ namespace Cpu {
 			#endif
 					graphs.resize(1);
 					graph_width = graph_default_width;
-					graphs[0] = Draw::Graph{ graph_width, graph_height, "cpu", safeVal(cpu.cpu_percent, graph_field), graph_symbol, invert, true };
+					graphs[0] = Draw::Graph{ graph_width, graph_height, "cpu", Shared::graph_data(safeVal(cpu.cpu_percent, graph_field), Cpu::history, graph_field), graph_symbol, invert, true, 0, 0, zoomed };
 			#ifdef GPU_SUPPORT
 				}
 			#endif
@@ -840,7 +877,7 @@ namespace Cpu {
 				(void)graph_height;
 				(void)graph_width;
 			#endif
-					out += graphs[0](safeVal(cpu.cpu_percent, graph_field), (data_same or redraw));
+					out += graphs[0](safeVal(cpu.cpu_percent, graph_field), (data_same or redraw or zoomed));
 			};
 
 			draw_graphs(graphs_upper, graph_up_height, graph_up_width, graph_up_field);
@@ -1233,6 +1270,9 @@ namespace Mem {
 	std::unordered_map<string, Draw::Meter> disk_meters_used;
 	std::unordered_map<string, Draw::Meter> disk_meters_free;
 	std::unordered_map<string, Draw::Graph> io_graphs;
+	//? Extended fields from mem_extended_fields that fit in the box, drawn as one row each at the bottom of the mem column
+	vector<extended_field> extended_shown;
+	array<Draw::Meter, extended_count> extended_meters;
 
 	string draw(const mem_info& mem, bool force_redraw, bool data_same) {
 		if (Runner::stopping) return "";
@@ -1242,15 +1282,28 @@ namespace Mem {
 		auto show_disks = Config::getB("show_disks");
 		auto show_io_stat = Config::getB("show_io_stat");
 		auto io_mode = Config::getB("io_mode");
+		//? Rows per disk for the await and queue depth graphs, which need room for their values. Only Linux collects them.
+	#ifdef __linux__
+		const int latency_rows = (Config::getB("show_io_latency") and disks_width >= 25 ? 2 : 0);
+	#else
+		constexpr int latency_rows = 0;
+	#endif
 		auto io_graph_combined = Config::getB("io_graph_combined");
 		auto use_graphs = Config::getB("mem_graphs");
+		const bool zoomed = Shared::history_tier() >= 0;
 		auto tty_mode = Config::getB("tty_mode");
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_mem"));
 		auto& graph_bg = Symbols::graph_symbols.at((graph_symbol == "default" ? Config::getS("graph_symbol") + "_up" : graph_symbol + "_up")).at(6);
 		auto totalMem = Mem::get_totalMem();
+		//? Memory and disks have their own update times, only the part that was collected is drawn unless redrawing
+		const bool draw_mem = redraw or collect_mem;
+		const bool draw_disks = show_disks and (redraw or collect_disks);
 		string out;
 		out.reserve(height * width);
 
+		const int mem_rows = height - (int)extended_shown.size();
+		const int extended_meter = max(0, mem_width - 19);
+
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out += box;
@@ -1264,26 +1317,29 @@ namespace Mem {
 			for (const auto& name : mem_names) {
 
 				if (use_graphs)
-					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name, safeVal(mem.percent, name), graph_symbol};
+					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name, Shared::graph_data(safeVal(mem.percent, name), Mem::history, name), graph_symbol, false, false, 0, 0, zoomed};
 				else
 					mem_meters[name] = Draw::Meter{mem_meter, name};
 			}
 			if (show_swap and has_swap) {
 				for (const auto& name : swap_names) {
 					if (use_graphs)
-						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name.substr(5), safeVal(mem.percent, name), graph_symbol};
+						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name.substr(5), Shared::graph_data(safeVal(mem.percent, name), Mem::history, name), graph_symbol, false, false, 0, 0, zoomed};
 					else
 						mem_meters[name] = Draw::Meter{mem_meter, name.substr(5)};
 				}
 			}
 
+			for (const auto field : extended_shown)
+				extended_meters[field] = Draw::Meter{extended_meter, "used"};
+
 			//? Disk meters and io graphs
 			if (show_disks) {
-				if (show_io_stat or io_mode) {
+				if (show_io_stat or io_mode or latency_rows > 0) {
 					std::unordered_map<string, int> custom_speeds;
 					int half_height = 0;
 					if (io_mode) {
-						disks_io_h = max((int)floor((double)(height - 2 - (disk_ios * 2)) / max(1, disk_ios)), (io_graph_combined ? 1 : 2));
+						disks_io_h = max((int)floor((double)(height - 2 - (disk_ios * (2 + latency_rows))) / max(1, disk_ios)), (io_graph_combined ? 1 : 2));
 						half_height = ceil((double)disks_io_h / 2);
 
 						if (not Config::getS("io_graph_speeds").empty()) {
@@ -1303,13 +1359,18 @@ namespace Mem {
 						if (disk.io_read.empty()) continue;
 
 						io_graphs[name + "_activity"] = Draw::Graph{disks_width - 6, 1, "available", disk.io_activity, graph_symbol};
+						if (latency_rows > 0 and not disk.io_await.empty()) {
+							io_graphs[name + "_await"] = Draw::Graph{disks_width - 12, 1, "used", disk.io_await, graph_symbol, false, false, 100 * 100};
+							io_graphs[name + "_queue"] = Draw::Graph{disks_width - 12, 1, "cached", disk.io_queue, graph_symbol, false, false, 32 * 100};
+						}
 
 						if (io_mode) {
 							//? Create one combined graph for IO read/write if enabled
 							long long speed = static_cast<long long>(custom_speeds.contains(name) ? custom_speeds.at(name) : 100) << 20;
 							if (io_graph_combined) {
-								deque<long long> combined(disk.io_read.size(), 0);
-								rng::transform(disk.io_read, disk.io_write, combined.begin(), std::plus<long long>());
+								RingBuffer<long long> combined;
+								for (size_t i = 0; i < min(disk.io_read.size(), disk.io_write.size()); i++)
+									combined.push_back(disk.io_read[i] + disk.io_write[i]);
 								io_graphs[name] = Draw::Graph{
 									disks_width, disks_io_h, "available", combined,
 									graph_symbol, false, true, speed};
@@ -1344,60 +1405,84 @@ namespace Mem {
 
 		//? Mem and swap
 		int cx = 1, cy = 1;
-		string divider = (graph_height > 0 ? Mv::l(2) + Theme::c("mem_box") + Symbols::div_left + Theme::c("div_line") + Symbols::h_line * (mem_width - 1)
-						+ (show_disks ? "" : Theme::c("mem_box")) + Symbols::div_right + Mv::l(mem_width - 1) + Theme::c("main_fg") : "");
-		string up = (graph_height >= 2 ? Mv::l(mem_width - 2) + Mv::u(graph_height - 1) : "");
-		bool big_mem = mem_width > 21;
-
-		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
-		vector<string> comb_names (mem_names.begin(), mem_names.end());
-		if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_names.begin(), swap_names.end());
-		for (const auto& name : comb_names) {
-			if (cy > height - 4) break;
-			string title;
-			if (name == "swap_used") {
-				if (cy > height - 5) break;
-				if (height - cy > 6) {
-					if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
+		string divider;
+		if (draw_mem) {
+			divider = (graph_height > 0 ? Mv::l(2) + Theme::c("mem_box") + Symbols::div_left + Theme::c("div_line") + Symbols::h_line * (mem_width - 1)
+							+ (show_disks ? "" : Theme::c("mem_box")) + Symbols::div_right + Mv::l(mem_width - 1) + Theme::c("main_fg") : "");
+			string up = (graph_height >= 2 ? Mv::l(mem_width - 2) + Mv::u(graph_height - 1) : "");
+			bool big_mem = mem_width > 21;
+
+			out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
+			vector<string> comb_names (mem_names.begin(), mem_names.end());
+			if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_names.begin(), swap_names.end());
+			for (const auto& name : comb_names) {
+				if (cy > mem_rows - 4) break;
+				string title;
+				if (name == "swap_used") {
+					if (cy > mem_rows - 5) break;
+					if (mem_rows - cy > 6) {
+						if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
+						cy += 1;
+					}
+					out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(safeVal(mem.stats, "swap_total"s)), mem_width - 8)
+						+ Theme::c("main_fg") + Fx::ub;
 					cy += 1;
+					title = "Used";
+				}
+				else if (name == "swap_free")
+					title = "Free";
+
+				if (title.empty()) title = capitalize(name);
+				const string humanized = floating_humanizer(safeVal(mem.stats, name));
+				const int offset = max(0, divider.empty() ? 9 - (int)humanized.size() : 0);
+				const string graphics = (
+					use_graphs and mem_graphs.contains(name) ? mem_graphs.at(name)(safeVal(mem.percent, name), redraw or data_same or zoomed)
+					: mem_meters.contains(name) ? mem_meters.at(name)(safeVal(mem.percent, name).back())
+					: "");
+				if (mem_size > 2) {
+					out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
+						+ Mv::to(y+1+cy, x+cx + mem_width - 2 - humanized.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + humanized : trans(humanized))
+						+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(safeVal(mem.percent, name).back()) + "%", 4);
+					cy += (graph_height == 0 ? 2 : graph_height + 1);
+				}
+				else {
+					out += Mv::to(y+1+cy, x+1+cx) + ljust(title, (mem_size > 1 ? 5 : 1)) + (graph_height >= 2 ? "" : " ")
+						+ graphics + Theme::c("title") + rjust(humanized, (mem_size > 1 ? 9 : 7));
+					cy += (graph_height == 0 ? 1 : graph_height);
 				}
-				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(safeVal(mem.stats, "swap_total"s)), mem_width - 8)
-					+ Theme::c("main_fg") + Fx::ub;
-				cy += 1;
-				title = "Used";
-			}
-			else if (name == "swap_free")
-				title = "Free";
-
-			if (title.empty()) title = capitalize(name);
-			const string humanized = floating_humanizer(safeVal(mem.stats, name));
-			const int offset = max(0, divider.empty() ? 9 - (int)humanized.size() : 0);
-			const string graphics = (
-				use_graphs and mem_graphs.contains(name) ? mem_graphs.at(name)(safeVal(mem.percent, name), redraw or data_same)
-				: mem_meters.contains(name) ? mem_meters.at(name)(safeVal(mem.percent, name).back())
-				: "");
-			if (mem_size > 2) {
-				out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
-					+ Mv::to(y+1+cy, x+cx + mem_width - 2 - humanized.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + humanized : trans(humanized))
-					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(safeVal(mem.percent, name).back()) + "%", 4);
-				cy += (graph_height == 0 ? 2 : graph_height + 1);
 			}
-			else {
-				out += Mv::to(y+1+cy, x+1+cx) + ljust(title, (mem_size > 1 ? 5 : 1)) + (graph_height >= 2 ? "" : " ")
-					+ graphics + Theme::c("title") + rjust(humanized, (mem_size > 1 ? 9 : 7));
-				cy += (graph_height == 0 ? 1 : graph_height);
+			if (graph_height > 0 and cy < mem_rows - 2)
+				out += Mv::to(y+1+cy, x+1+cx) + divider;
+
+			//? Extended fields, meters show the percentage of total memory
+			static constexpr array<string_view, extended_count> extended_titles { "Dirty:", "Wrback:", "Shmem:", "Slab:", "Huge:", "Commit:" };
+			for (int row = y + mem_rows - 1; const auto field : extended_shown) {
+				const bool valid = mem.extended_valid & (1u << field);
+				const uint64_t value = mem.extended[field];
+				out += Mv::to(row++, x + 2) + Theme::c("title") + ljust(string(extended_titles[field]), 7) + Theme::c("main_fg")
+					+ extended_meters[field](valid ? (int)round((double)value * 100 / totalMem) : 0)
+					+ Theme::c("title") + rjust(valid ? floating_humanizer(value) : "n/a"s, mem_width - 10 - extended_meter) + Theme::c("main_fg");
 			}
 		}
-		if (graph_height > 0 and cy < height - 2)
-			out += Mv::to(y+1+cy, x+1+cx) + divider;
 
 		//? Disks
-		if (show_disks) {
+		if (draw_disks) {
 			const auto& disks = mem.disks;
 			cx = mem_width; cy = 0;
 			bool big_disk = disks_width >= 25;
 			divider = Mv::l(1) + Theme::c("div_line") + Symbols::div_left + Symbols::h_line * disks_width + Theme::c("mem_box") + Fx::ub + Symbols::div_right + Mv::l(disks_width);
 			const string hu_div = Theme::c("div_line") + Symbols::h_line + Theme::c("main_fg");
+
+			//? Await and queue depth rows, values are fixed-point hundredths
+			auto hundredths = [](long long value, const string& unit) {
+				if (value >= 10'000) return fmt::format("{}{}", value / 100, unit);
+				if (value >= 1'000) return fmt::format("{}.{}{}", value / 100, value / 10 % 10, unit);
+				return fmt::format("{}.{:02}{}", value / 100, value % 100, unit);
+			};
+			auto latency_row = [&](const string& graph, const string& label, const RingBuffer<long long>& data, const string& unit) {
+				return Mv::to(y+1+cy++, x+1+cx) + label + Theme::c("inactive_fg") + graph_bg * (disks_width - 12) + Mv::l(disks_width - 12)
+					+ io_graphs.at(graph)(data, redraw or data_same) + Theme::c("main_fg") + rjust(hundredths(data.back(), unit), 6);
+			};
 			if (io_mode) {
 				for (const auto& mount : mem.disks_order) {
 					if (not disks.contains(mount)) continue;
@@ -1416,13 +1501,18 @@ namespace Mem {
 						+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
 					}
 					if (++cy > height - 3) break;
+					if (latency_rows > 0 and io_graphs.contains(mount + "_await")) {
+						if (cy + latency_rows > height - 2) break;
+						out += latency_row(mount + "_await", " Lat ", disk.io_await, "ms");
+						out += latency_row(mount + "_queue", " Qd  ", disk.io_queue, "");
+					}
 					if (io_graph_combined) {
 						if (not io_graphs.contains(mount)) continue;
 						auto comb_val = disk.io_read.back() + disk.io_write.back();
 						const string humanized = (disk.io_write.back() > 0 ? "▼"s : ""s) + (disk.io_read.back() > 0 ? "▲"s : ""s)
 												+ (comb_val > 0 ? Mv::r(1) + floating_humanizer(comb_val, true) : "RW");
 						if (disks_io_h == 1) out += Mv::to(y+1+cy, x+1+cx) + string(5, ' ');
-						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)({comb_val}, redraw or data_same)
+						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)(RingBuffer<long long>{comb_val}, redraw or data_same)
 							+ Mv::to(y+1+cy, x+1+cx) + Theme::c("main_fg") + humanized;
 						cy += disks_io_h;
 					}
@@ -1462,16 +1552,21 @@ namespace Mem {
 						if (not big_disk) out += Mv::to(y+1+cy, x+cx+1) + Theme::c("main_fg") + human_io;
 						if (++cy > height - 3) break;
 					}
+					if (latency_rows > 0 and io_graphs.contains(mount + "_await")) {
+						if (cy + latency_rows > height - 2) break;
+						out += latency_row(mount + "_await", " Lat ", disk.io_await, "ms");
+						out += latency_row(mount + "_queue", " Qd  ", disk.io_queue, "");
+					}
 
 					out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " Used:" + rjust(to_string(disk.used_percent) + '%', 4) : "U") + ' '
 						+ disk_meters_used.at(mount)(disk.used_percent) + rjust(human_used, (big_disk ? 9 : 5));
 					if (++cy > height - 3) break;
 
-					if (disk_meters_free.contains(mount) and cmp_less_equal(disks.size() * 3 + (show_io_stat ? disk_ios : 0), height - 1)) {
+					if (disk_meters_free.contains(mount) and cmp_less_equal(disks.size() * 3 + (show_io_stat ? disk_ios : 0) + latency_rows * disk_ios, height - 1)) {
 						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " Free:" + rjust(to_string(disk.free_percent) + '%', 4) : "F") + ' '
 						+ disk_meters_free.at(mount)(disk.free_percent) + rjust(human_free, (big_disk ? 9 : 5));
 						cy++;
-						if (cmp_less_equal(disks.size() * 4 + (show_io_stat ? disk_ios : 0), height - 1)) cy++;
+						if (cmp_less_equal(disks.size() * 4 + (show_io_stat ? disk_ios : 0) + latency_rows * disk_ios, height - 1)) cy++;
 					}
 
 				}
@@ -1503,6 +1598,7 @@ namespace Net {
 		auto net_auto = Config::getB("net_auto");
 		auto tty_mode = Config::getB("tty_mode");
 		auto swap_upload_download = Config::getB("swap_upload_download");
+		const bool zoomed = Shared::history_tier() >= 0;
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_net"));
 		string ip_addr = (net.ipv4.empty() ? net.ipv6 : net.ipv4);
 		if (old_ip != ip_addr) {
@@ -1527,11 +1623,11 @@ namespace Net {
 
 			graphs["download"] = Draw::Graph{
 				width - b_width - 2, u_graph_height, "download",
-				net.bandwidth.at("download"), graph_symbol,
-				swap_upload_download, true, down_max};
+				Shared::graph_data(net.bandwidth.at("download"), Net::history, selected_iface + ":download"), graph_symbol,
+				swap_upload_download, true, down_max, 0, zoomed};
 			graphs["upload"] = Draw::Graph{
 				width - b_width - 2, d_graph_height, "upload",
-				net.bandwidth.at("upload"), graph_symbol, !swap_upload_download, true, up_max};
+				Shared::graph_data(net.bandwidth.at("upload"), Net::history, selected_iface + ":upload"), graph_symbol, !swap_upload_download, true, up_max, 0, zoomed};
 
 			//? Interface selector and buttons
 
@@ -1569,7 +1665,7 @@ namespace Net {
 			} else {
 				out += Mv::to(y + u_graph_height + 1 + ((height * swap_upload_download) % 2), x + 1);
 			}
-			out += graphs.at(dir)(safeVal(net.bandwidth, dir), redraw or data_same or not net.connected)
+			out += graphs.at(dir)(safeVal(net.bandwidth, dir), redraw or data_same or zoomed or not net.connected)
 				+ Mv::to(y+1 + (((dir == "upload") == (!swap_upload_download)) * (height - 3)), x + 1) + Fx::ub + Theme::c("graph_text")
 				+ floating_humanizer((dir == "upload" ? up_max : down_max), true);
 			const string speed = floating_humanizer(safeVal(net.stat, dir).speed, false, 0, false, true);
@@ -2059,7 +2155,7 @@ namespace Proc {
 			bool has_graph = show_graphs ? p_counters.contains(p.pid) : false;
 			if (show_graphs and ((p.cpu_p > 0 and not has_graph) or (not data_same and has_graph))) {
 				if (not has_graph) {
-					p_graphs[p.pid] = Draw::Graph{5, 1, "", {}, graph_symbol};
+					p_graphs[p.pid] = Draw::Graph{5, 1, "", RingBuffer<long long>{}, graph_symbol};
 					p_counters[p.pid] = 0;
 				}
 				else if (p.cpu_p < 0.1 and ++p_counters[p.pid] >= 10) {
@@ -2166,7 +2262,7 @@ namespace Proc {
 				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
 				+ m_color + rjust(mem_str, 5) + end + ' '
 				+ (is_selected or is_followed ? "" : Theme::c("inactive_fg")) + (show_graphs ? graph_bg * 5: "")
-				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
+				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)(RingBuffer<long long>{(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
 				+ c_color + rjust(cpu_str, 4) + "  " + end;
 			if (lc++ > height - 5) break;
 			else if (lc > height - 5 and proc_banner_shown) break;
@@ -2462,7 +2558,19 @@ namespace Draw {
 				mem_width = width - 1;
 
 			item_height = has_swap and not swap_disk ? 6 : 4;
-			if (height - (has_swap and not swap_disk ? 3 : 2) > 2 * item_height)
+
+			//? Rows for the extended fields are taken from the mem values, as long as room for the minimum layout is left
+			extended_shown.clear();
+		#ifdef __linux__
+			for (const auto& name : ssplit(Config::getS("mem_extended_fields"))) {
+				const auto field = static_cast<extended_field>(std::ranges::find(extended_names, name) - extended_names.begin());
+				if (field < extended_count and not v_contains(extended_shown, field) and height - (int)extended_shown.size() - 3 > item_height)
+					extended_shown.push_back(field);
+			}
+		#endif
+			const int mem_rows = height - (int)extended_shown.size();
+
+			if (mem_rows - (has_swap and not swap_disk ? 3 : 2) > 2 * item_height)
 				mem_size = 3;
 			else if (mem_width > 25)
 				mem_size = 2;
@@ -2473,7 +2581,7 @@ namespace Draw {
 			if (mem_size == 1) mem_meter += 6;
 
 			if (mem_graphs) {
-				graph_height = max(1, (int)round((double)((height - (has_swap and not swap_disk ? 2 : 1)) - (mem_size == 3 ? 2 : 1) * item_height) / item_height));
+				graph_height = max(1, (int)round((double)((mem_rows - (has_swap and not swap_disk ? 2 : 1)) - (mem_size == 3 ? 2 : 1) * item_height) / item_height));
 				if (graph_height > 1) mem_meter += 6;
 			}
 			else
@@ -19,16 +19,18 @@ tab-size = 4
 #pragma once
 
 #include <array>
-#include <deque>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "btop_ringbuffer.hpp"
+
 using std::array;
-using std::deque;
 using std::string;
 using std::vector;
+using Tools::RingBuffer;
 
 namespace Symbols {
 	extern const string h_line;
@@ -102,29 +104,56 @@ namespace Draw {
 
 	//* Class holding a percentage graph
 	class Graph {
-		int width, height;
+		int width = 0, height = 0;
 		string color_gradient;
 		string out, symbol = "default";
-		bool invert, no_zero;
+		bool invert, no_zero, gaps;
 		long long offset;
 		long long last = 0, max_value = 0;
 		bool current = true, tty_mode = false;
-		std::unordered_map<bool, vector<string>> graphs = { {true, {}}, {false, {}}};
+
+		//? Rendered bytes of each row in the two representations, new columns are appended and the oldest are skipped by moving <start> forward
+		struct row_buffer {
+			string bytes;
+			size_t start = 0;
+		};
+		array<vector<row_buffer>, 2> rows;
+
+		//? Size in bytes of every cell, each row is a ring of <width> columns where <head> is the oldest
+		array<vector<uint8_t>, 2> cell_sizes;
+		array<int, 2> head = {0, 0};
+
+		//? Number of dots (0-4) a value of 0-100 fills in each row, precomputed for the height of the graph
+		vector<array<uint8_t, 101>> levels;
+		const vector<string>* glyphs = nullptr;
+		string skip;
 
 		//* Create two representations of the graph to switch between to represent two values for each braille character
-		void _create(const deque<long long>& data, int data_offset);
+		template <typename T>
+		void _create(const RingBuffer<T>& data, int data_offset);
+
+		//* Replace the oldest column in the current representation with a character for the values <prev> and <value>
+		void _push(long long prev, long long value, bool first);
+
+		//* Write the current representation to <out>
+		void _render();
 
 	public:
 		Graph();
+
+		//* Set <gaps> when <data> is a zoomed out history, its history_gap<T> steps are then drawn blank
+		template <typename T>
 		Graph(int width, int height,
 			const string& color_gradient,
-			const deque<long long>& data,
+			const RingBuffer<T>& data,
 			const string& symbol="default",
 			bool invert=false, bool no_zero=false,
-			long long max_value=0, long long offset=0);
+			long long max_value=0, long long offset=0,
+			bool gaps=false);
 
 		//* Add last value from back of <data> and return string representation of graph
-		string& operator()(const deque<long long>& data, bool data_same=false);
+		template <typename T>
+		string& operator()(const RingBuffer<T>& data, bool data_same=false);
 
 		//* Return string representation of graph
 		string& operator()();
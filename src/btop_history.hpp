@@ -0,0 +1,103 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "btop_ringbuffer.hpp"
+
+namespace Tools {
+
+	//* Value stored for time steps without samples, e.g. after a suspend, graphs draw it as a blank column
+	template <std::integral T>
+	constexpr T history_gap = std::numeric_limits<T>::max();
+
+	//* Long term history for one metric, stored as fixed size tiers of consolidated samples in the style of a round robin database.
+	//* Every tier keeps the minimum, average and maximum of the samples collected during each of its time steps,
+	//* so memory use is bounded by tier_slots regardless of how long btop has been running.
+	template <std::integral T>
+	class TieredHistory {
+	public:
+		enum class consolidation { min, avg, max };
+
+		static constexpr size_t tier_count = 3;
+		static constexpr size_t tier_slots = 512;
+		static constexpr std::array<uint64_t, tier_count> tier_steps { 10'000, 60'000, 600'000 };
+		static constexpr std::array<std::string_view, tier_count> tier_names { "10s", "1m", "10m" };
+
+	private:
+		struct tier {
+			uint64_t slot{};
+			long long sum{};
+			long long low = std::numeric_limits<long long>::max();
+			long long high = std::numeric_limits<long long>::min();
+			uint32_t samples{};
+			std::array<RingBuffer<T>, 3> series;
+
+			void push(long long min_value, long long avg_value, long long max_value) {
+				const std::array values { min_value, avg_value, max_value };
+				for (size_t i = 0; i < values.size(); i++) {
+					if (series[i].size() == tier_slots) series[i].pop_front();
+					series[i].push_back(values[i]);
+				}
+			}
+		};
+		std::array<tier, tier_count> tiers;
+
+	public:
+		//* Add a sample taken at <now_ms>, returns a bitmask of the tiers that completed a time step
+		unsigned add(uint64_t now_ms, long long value) {
+			unsigned advanced = 0;
+			for (size_t i = 0; i < tier_count; i++) {
+				auto& t = tiers[i];
+				const uint64_t slot = now_ms / tier_steps[i];
+				if (t.samples > 0 and slot != t.slot) {
+					t.push(t.low, t.sum / t.samples, t.high);
+
+					//? Keep the time axis aligned by adding gap steps for periods without samples
+					if (slot > t.slot)
+						for (uint64_t gap = std::min<uint64_t>(slot - t.slot - 1, tier_slots); gap > 0; gap--)
+							t.push(history_gap<T>, history_gap<T>, history_gap<T>);
+
+					t.sum = t.samples = 0;
+					t.low = std::numeric_limits<long long>::max();
+					t.high = std::numeric_limits<long long>::min();
+					advanced |= 1u << i;
+				}
+				t.slot = slot;
+				t.sum += value;
+				t.low = std::min(t.low, value);
+				t.high = std::max(t.high, value);
+				t.samples++;
+			}
+			return advanced;
+		}
+
+		//* Completed time steps of tier <index>, oldest first, steps without samples hold history_gap<T>
+		[[nodiscard]] const RingBuffer<T>& series(size_t index, consolidation type) const {
+			return tiers.at(index).series[static_cast<size_t>(type)];
+		}
+	};
+
+}
@@ -311,6 +311,26 @@ namespace Menu {
 				"",
 				"Min value: 100 ms",
 				"Max value: 86400000 ms = 24 hours."},
+			{"concurrent_collect",
+				"Collect box data concurrently.",
+				"",
+				"Collect the data for each shown box at",
+				"the same time on separate threads.",
+				"",
+				"Shortens updates when one box, like proc",
+				"or gpu, is slow to collect.",
+				"",
+				"True or False."},
+			{"metrics_listen",
+				"Prometheus metrics listener.",
+				"",
+				"Serve the values of the shown boxes in",
+				"Prometheus text format on this address.",
+				"",
+				"An absolute path for a unix socket, or a",
+				"port number to listen on 127.0.0.1.",
+				"",
+				"Empty to disable."},
 			{"rounded_corners",
 				"Rounded corners on boxes.",
 				"",
@@ -324,6 +344,39 @@ namespace Menu {
 				"to reduce flickering on supported terminals.",
 				"",
 				"True or False."},
+			{"screen_diff",
+				"Only send changed parts of the screen.",
+				"",
+				"Keep a copy of the screen and only send",
+				"the cells that changed since last update.",
+				"",
+				"Reduces the amount of data written each",
+				"update, useful over ssh on slow connections.",
+				"",
+				"Uses some extra cpu and memory.",
+				"",
+				"True or False."},
+			{"adaptive_output",
+				"Adapt to slow terminals.",
+				"",
+				"Hold back updates while the terminal can't",
+				"keep up with the output, e.g. over a slow",
+				"ssh connection.",
+				"",
+				"Held back updates are merged into the next",
+				"one sent and the process box is updated",
+				"less often until output catches up.",
+				"",
+				"True or False."},
+			{"output_rate_limit",
+				"Limit output rate in KiB per second.",
+				"",
+				"Updates over the limit are held back and",
+				"merged into the next one sent.",
+				"",
+				"0 to disable.",
+				"",
+				"Max value: 1000000"},
 			{"graph_symbol",
 				"Default symbols to use for graph creation.",
 				"",
@@ -341,6 +394,27 @@ namespace Menu {
 				"Note that \"tty\" only has half the horizontal",
 				"resolution of the other two,",
 				"so will show a shorter historical view."},
+			{"history_zoom",
+				"Time per step in cpu, mem and net graphs.",
+				"",
+				"\"Live\" shows every collected sample.",
+				"",
+				"\"10s\", \"1m\" and \"10m\" zoom out to a long",
+				"term history that is always recorded in",
+				"the background, up to 512 steps per level.",
+				"Steps without samples are left blank.",
+				"",
+				"Only the main cpu graphs, the mem graphs",
+				"and the net graphs zoom, core and gpu",
+				"graphs always show live samples.",
+				"",
+				"The graphs are updated once per step."},
+			{"history_consolidation",
+				"Value shown for each step in zoomed out",
+				"graphs.",
+				"",
+				"\"avg\", \"min\" or \"max\" of the samples",
+				"collected during the step."},
 			{"clock_format",
 				"Draw a clock at top of screen.",
 				"(Only visible if cpu box is enabled!)",
@@ -415,6 +489,13 @@ namespace Menu {
 				"",
 				"Show cpu box at bottom of screen instead",
 				"of top."},
+			{"update_ms_cpu",
+				"Update time of the cpu box in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
 			{"graph_symbol_cpu",
 				"Graph symbol to use for graphs in cpu box.",
 				"",
@@ -588,6 +669,15 @@ namespace Menu {
 				"May impact performance on certain cards.",
 				"",
 				"True or False."},
+			{"update_ms_gpu",
+				"Update time of the gpu boxes in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Also used for gpu info shown in the cpu box.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
 			{"graph_symbol_gpu",
 				"Graph symbol to use for graphs in gpu box.",
 				"",
@@ -638,6 +728,23 @@ namespace Menu {
 				"Mem box location.",
 				"",
 				"Show mem box below net box instead of above."},
+			{"update_ms_mem",
+				"Update time of the mem box in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
+			{"update_ms_disks",
+				"Update time of the disks in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Disks are collected less often than memory",
+				"if set higher than update_ms_mem.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
 			{"graph_symbol_mem",
 				"Graph symbol to use for graphs in mem box.",
 				"",
@@ -659,6 +766,19 @@ namespace Menu {
 				"(disk busy time) when not in IO mode.",
 				"",
 				"True or False."},
+		#ifdef __linux__
+			{"show_io_latency",
+				"Toggle IO latency and queue depth graphs.",
+				"",
+				"Show graphs of the average time per",
+				"request (await) and the average number of",
+				"requests in flight (queue depth) for disks.",
+				"",
+				"Await tops out at 100 ms and queue depth",
+				"at 32. Linux only.",
+				"",
+				"True or False."},
+		#endif
 			{"io_mode",
 				"Toggles io mode for disks.",
 				"",
@@ -745,8 +865,30 @@ namespace Menu {
 				"kernel as used memory.",
 				"",
 				"True or False."},
+		#ifdef __linux__
+			{"mem_extended_fields",
+				"Extra memory fields shown as meters.",
+				"",
+				"Shown one per row below the memory values,",
+				"as a percentage of total memory.",
+				"Separate multiple values with",
+				"whitespace \" \".",
+				"",
+				"Available values: dirty, writeback, shmem,",
+				"slab, hugepages (allocated huge pages)",
+				"and committed (Committed_AS).",
+				"",
+				"Example: \"dirty writeback committed\""},
+		#endif
 		},
 		{
+			{"update_ms_net",
+				"Update time of the net box in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
 			{"graph_symbol_net",
 				"Graph symbol to use for graphs in net box.",
 				"",
@@ -810,6 +952,13 @@ namespace Menu {
 				"",
 				"Show proc box on left side of screen",
 				"instead of right."},
+			{"update_ms_proc",
+				"Update time of the proc box in milliseconds.",
+				"",
+				"0 to use the update time set by update_ms.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
 			{"graph_symbol_proc",
 				"Graph symbol to use for graphs in proc box.",
 				"",
@@ -895,6 +1044,46 @@ namespace Menu {
 				"",
 				"Set to 'True' to filter out internal",
 				"processes started by the Linux kernel."},
+			{"proc_collect_threads",
+				"(Linux) Threads for process collection.",
+				"",
+				"Number of threads used to read process",
+				"information from /proc.",
+				"",
+				"Set to 1 to disable parallel collection.",
+				"",
+				"Set to 0 to use one thread per 512",
+				"processes, up to the number of cpu cores.",
+				"",
+				"Min value: 0",
+				"Max value: 256"},
+			{"proc_lazy_cmdline",
+				"(Linux) Read command lines on demand.",
+				"",
+				"Only read the command line of processes",
+				"when shown in the list, when filtering",
+				"or when sorting by command.",
+				"",
+				"Saves reading files for short lived",
+				"processes on busy systems."},
+			{"proc_events",
+				"(Linux) Track processes with events.",
+				"",
+				"Get notified by the kernel when processes",
+				"start and exit instead of scanning all of",
+				"/proc every update.",
+				"",
+				"Requires CAP_NET_ADMIN (running as root),",
+				"falls back to scanning /proc otherwise."},
+			{"proc_io_uring",
+				"(Linux) Batch process reads with io_uring.",
+				"",
+				"Read the stat files of all processes with",
+				"a few io_uring calls instead of three",
+				"system calls per process.",
+				"",
+				"Falls back to plain reads if io_uring is",
+				"not available or disabled."},
 			{"proc_follow_detailed",
 				"Follow selected process with detailed view",
 				"",
@@ -1325,6 +1514,8 @@ static int optionsMenu(const string& key) {
 			{"graph_symbol_mem", std::cref(Config::valid_graph_symbols_def)},
 			{"graph_symbol_net", std::cref(Config::valid_graph_symbols_def)},
 			{"graph_symbol_proc", std::cref(Config::valid_graph_symbols_def)},
+			{"history_zoom", std::cref(Config::history_zoom_values)},
+			{"history_consolidation", std::cref(Config::history_consolidations)},
 			{"cpu_graph_upper", std::cref(Cpu::available_fields)},
 			{"cpu_graph_lower", std::cref(Cpu::available_fields)},
 			{"cpu_sensor", std::cref(Cpu::available_sensors)},
@@ -1482,7 +1673,7 @@ static int optionsMenu(const string& key) {
 		else if (is_in(key, "left", "right") or (vim_keys and is_in(key, "h", "l"))) {
 			const auto& option = categories[selected_cat][item_height * page + selected][0];
 			if (selPred.test(isInt)) {
-				const int mod = (option == "update_ms" ? 100 : 1);
+				const int mod = (option.starts_with("update_ms") ? 100 : option == "output_rate_limit" ? 16 : 1);
 				long value = Config::getI(option);
 				if (key == "right" or (vim_keys and key == "l")) value += mod;
 				else value -= mod;
@@ -1573,7 +1764,7 @@ static int optionsMenu(const string& key) {
 					else if (option == "base_10_bitrate") {
 						recollect = true;
 					}
-					else if (is_in(option, "proc_sorting", "cpu_sensor", "show_gpu_info") or option.starts_with("graph_symbol") or option.starts_with("cpu_graph_"))
+					else if (is_in(option, "proc_sorting", "cpu_sensor", "show_gpu_info") or option.starts_with("graph_symbol") or option.starts_with("cpu_graph_") or option.starts_with("history_"))
 						screen_redraw = true;
 					else if (option == "disable_presets" and optList.at(i) != "Off") {
 						atomic_wait(Runner::active);
@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_metrics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "btop_log.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+using std::string_view;
+
+namespace Metrics {
+
+	namespace {
+		//? Rendered metrics of each box, a box keeps its last text until it's collected again
+		string cpu_text, mem_text, net_text, gpu_text, proc_text;
+		vector<const Proc::proc_info*> top;
+		uint64_t total_mem{};
+
+		//? The snapshot is replaced as a whole, the mutex only guards swapping and copying the pointer
+		std::mutex snapshot_mtx;
+		std::shared_ptr<const string> current = std::make_shared<const string>();
+
+		string listen_addr;
+		string socket_path;
+		int listen_fd = -1;
+		std::array<int, 2> wake_pipe { -1, -1 };
+		std::thread server;
+
+		//? Clients get this long to send their request before the connection is closed
+		constexpr int request_timeout_ms = 1000;
+
+		void family(string& out, string_view name, string_view type, string_view help) {
+			fmt::format_to(std::back_inserter(out), "# HELP {0} {1}\n# TYPE {0} {2}\n", name, help, type);
+		}
+
+		//? Label values escape backslash, double quote and line feed
+		string escape(string_view value) {
+			string escaped;
+			for (const char c : value) {
+				if (c == '\n') escaped += "\\n";
+				else {
+					if (c == '\\' or c == '"') escaped += '\\';
+					escaped += c;
+				}
+			}
+			return escaped;
+		}
+
+		void render_cpu(const Cpu::cpu_info& cpu) {
+			auto& out = cpu_text;
+			out.clear();
+			auto it = std::back_inserter(out);
+			family(out, "btop_cpu_usage_percent", "gauge", "Cpu usage in percent, of all cores and per core.");
+			if (const auto& total = cpu.cpu_percent.at("total"); not total.empty())
+				fmt::format_to(it, "btop_cpu_usage_percent{{core=\"total\"}} {}\n", total.back());
+			for (size_t i = 0; i < cpu.core_percent.size(); i++) {
+				if (not cpu.core_percent[i].empty())
+					fmt::format_to(it, "btop_cpu_usage_percent{{core=\"{}\"}} {}\n", i, cpu.core_percent[i].back());
+			}
+			family(out, "btop_load_average", "gauge", "System load average.");
+			for (size_t i = 0; const auto period : { "1m", "5m", "15m" })
+				fmt::format_to(it, "btop_load_average{{period=\"{}\"}} {}\n", period, cpu.load_avg[i++]);
+			if (not cpu.temp.empty() and not cpu.temp[0].empty()) {
+				family(out, "btop_cpu_temperature_celsius", "gauge", "Cpu package temperature.");
+				fmt::format_to(it, "btop_cpu_temperature_celsius {}\n", cpu.temp[0].back());
+			}
+		}
+
+		void render_mem(const Mem::mem_info& mem) {
+			auto& out = mem_text;
+			out.clear();
+			auto it = std::back_inserter(out);
+			family(out, "btop_memory_bytes", "gauge", "System memory.");
+			fmt::format_to(it, "btop_memory_bytes{{type=\"total\"}} {}\n", total_mem);
+			for (const auto& name : Mem::mem_names)
+				fmt::format_to(it, "btop_memory_bytes{{type=\"{}\"}} {}\n", name, mem.stats.at(name));
+			for (size_t i = 0; i < mem.extended.size(); i++) {
+				if (mem.extended_valid & (1u << i))
+					fmt::format_to(it, "btop_memory_bytes{{type=\"{}\"}} {}\n", Mem::extended_names[i], mem.extended[i]);
+			}
+			family(out, "btop_swap_bytes", "gauge", "Swap space.");
+			for (const auto name : { "total", "used", "free" })
+				fmt::format_to(it, "btop_swap_bytes{{type=\"{}\"}} {}\n", name, mem.stats.at(string("swap_") + name));
+			if (mem.disks_order.empty()) return;
+			family(out, "btop_disk_bytes", "gauge", "Disk space of the mountpoints shown in the mem box.");
+			for (const auto& mountpoint : mem.disks_order) {
+				const auto disk = mem.disks.find(mountpoint);
+				if (disk == mem.disks.end()) continue;
+				const string labels = fmt::format("mount=\"{}\",name=\"{}\"", escape(mountpoint), escape(disk->second.name));
+				fmt::format_to(it, "btop_disk_bytes{{{},type=\"total\"}} {}\n", labels, disk->second.total);
+				fmt::format_to(it, "btop_disk_bytes{{{},type=\"used\"}} {}\n", labels, disk->second.used);
+				fmt::format_to(it, "btop_disk_bytes{{{},type=\"free\"}} {}\n", labels, disk->second.free);
+			}
+		}
+
+		void render_net(const std::unordered_map<string, Net::net_info>& nets) {
+			auto& out = net_text;
+			out.clear();
+			auto it = std::back_inserter(out);
+			family(out, "btop_network_bytes_per_second", "gauge", "Network interface speed.");
+			for (const auto& [iface, net] : nets) {
+				for (const auto& [direction, stat] : net.stat)
+					fmt::format_to(it, "btop_network_bytes_per_second{{iface=\"{}\",direction=\"{}\"}} {}\n", escape(iface), direction, stat.speed);
+			}
+			family(out, "btop_network_bytes_total", "counter", "Bytes transferred by a network interface since btop started.");
+			for (const auto& [iface, net] : nets) {
+				for (const auto& [direction, stat] : net.stat)
+					fmt::format_to(it, "btop_network_bytes_total{{iface=\"{}\",direction=\"{}\"}} {}\n", escape(iface), direction, stat.total);
+			}
+		}
+
+	#ifdef GPU_SUPPORT
+		void render_gpus(const vector<Gpu::gpu_info>& gpus) {
+			auto& out = gpu_text;
+			out.clear();
+			if (gpus.empty()) return;
+			auto it = std::back_inserter(out);
+			auto labels = [&](size_t i) {
+				return fmt::format("gpu=\"{}\",name=\"{}\"", i, escape(i < Gpu::gpu_names.size() ? Gpu::gpu_names[i] : ""));
+			};
+			family(out, "btop_gpu_utilization_percent", "gauge", "Gpu utilization in percent.");
+			for (size_t i = 0; i < gpus.size(); i++) {
+				if (const auto& util = gpus[i].gpu_percent.at("gpu-totals"); not util.empty())
+					fmt::format_to(it, "btop_gpu_utilization_percent{{{}}} {}\n", labels(i), util.back());
+			}
+			family(out, "btop_gpu_memory_bytes", "gauge", "Gpu memory.");
+			for (size_t i = 0; i < gpus.size(); i++) {
+				fmt::format_to(it, "btop_gpu_memory_bytes{{{},type=\"total\"}} {}\n", labels(i), gpus[i].mem_total);
+				fmt::format_to(it, "btop_gpu_memory_bytes{{{},type=\"used\"}} {}\n", labels(i), gpus[i].mem_used);
+			}
+			family(out, "btop_gpu_temperature_celsius", "gauge", "Gpu temperature.");
+			for (size_t i = 0; i < gpus.size(); i++) {
+				if (not gpus[i].temp.empty())
+					fmt::format_to(it, "btop_gpu_temperature_celsius{{{}}} {}\n", labels(i), gpus[i].temp.back());
+			}
+			family(out, "btop_gpu_power_watts", "gauge", "Gpu power usage.");
+			for (size_t i = 0; i < gpus.size(); i++)
+				fmt::format_to(it, "btop_gpu_power_watts{{{}}} {}\n", labels(i), gpus[i].pwr_usage / 1000.0);
+		}
+	#endif
+
+		void render_procs(const vector<Proc::proc_info>& procs) {
+			auto& out = proc_text;
+			out.clear();
+			top.clear();
+			for (const auto& p : procs) top.push_back(&p);
+			const auto count = std::min(top_procs, top.size());
+			std::partial_sort(top.begin(), top.begin() + count, top.end(), [](const auto* a, const auto* b) { return a->cpu_p > b->cpu_p; });
+			top.resize(count);
+
+			auto it = std::back_inserter(out);
+			auto labels = [](const Proc::proc_info& p) {
+				return fmt::format("pid=\"{}\",name=\"{}\",user=\"{}\"", p.pid, escape(p.name), escape(p.user));
+			};
+			family(out, "btop_process_cpu_percent", "gauge", "Cpu usage of the processes using the most cpu.");
+			for (const auto* p : top)
+				fmt::format_to(it, "btop_process_cpu_percent{{{}}} {:.1f}\n", labels(*p), p->cpu_p);
+			family(out, "btop_process_memory_bytes", "gauge", "Resident memory of the processes using the most cpu.");
+			for (const auto* p : top)
+				fmt::format_to(it, "btop_process_memory_bytes{{{}}} {}\n", labels(*p), p->mem);
+		}
+
+		//* Answer one HTTP request on <fd> with the current snapshot
+		void respond(int fd) {
+			std::array<char, 4096> request;
+			size_t received = 0;
+			//? Read until the end of the request headers, anything after them is ignored
+			while (received < request.size()) {
+				pollfd pfd { fd, POLLIN, 0 };
+				if (poll(&pfd, 1, request_timeout_ms) <= 0) return;
+				const auto bytes = recv(fd, request.data() + received, request.size() - received, 0);
+				if (bytes <= 0) return;
+				received += bytes;
+				if (string_view(request.data(), received).contains("\r\n\r\n")) break;
+			}
+			const string_view req(request.data(), received);
+			const auto target = req.substr(0, req.find_first_of("\r\n"));
+
+			string response;
+			std::shared_ptr<const string> body;
+			if (not target.starts_with("GET ") and not target.starts_with("HEAD ")) {
+				response = "HTTP/1.0 405 Method Not Allowed\r\nAllow: GET, HEAD\r\nContent-Length: 0\r\n\r\n";
+			}
+			else if (const auto path = target.substr(target.find(' ') + 1); not path.starts_with("/metrics ") and not path.starts_with("/ ")) {
+				response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+			}
+			else {
+				body = snapshot();
+				response = fmt::format("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: {}\r\n\r\n", body->size());
+				if (target.starts_with("GET ")) response += *body;
+			}
+
+			int flags = 0;
+		#ifdef MSG_NOSIGNAL
+			flags = MSG_NOSIGNAL;
+		#endif
+			string_view rest = response;
+			while (not rest.empty()) {
+				pollfd pfd { fd, POLLOUT, 0 };
+				if (poll(&pfd, 1, request_timeout_ms) <= 0) return;
+				const auto sent = send(fd, rest.data(), rest.size(), flags);
+				if (sent < 0 and errno == EINTR) continue;
+				if (sent <= 0) return;
+				rest.remove_prefix(sent);
+			}
+		}
+
+		void serve(int fd, int wake) {
+			//? Signals are handled by the main thread
+			sigset_t mask;
+			sigfillset(&mask);
+			pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+			std::array<pollfd, 2> pfds {{ { fd, POLLIN, 0 }, { wake, POLLIN, 0 } }};
+			for (;;) {
+				if (poll(pfds.data(), pfds.size(), -1) < 0) {
+					if (errno == EINTR) continue;
+					Logger::warning("Metrics: poll() failed: {}", strerror(errno));
+					return;
+				}
+				if (pfds[1].revents != 0) return;
+				if ((pfds[0].revents & POLLIN) == 0) continue;
+
+				const int client = accept(fd, nullptr, nullptr);
+				if (client < 0) continue;
+			#ifdef SO_NOSIGPIPE
+				const int one = 1;
+				setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+			#endif
+				respond(client);
+				close(client);
+			}
+		}
+
+		//? Create the listening socket, returns -1 and logs a warning on failure
+		int open_socket(const string& listen) {
+			int fd = -1;
+			if (listen.starts_with('/')) {
+				sockaddr_un addr {};
+				if (listen.size() >= sizeof(addr.sun_path)) {
+					Logger::warning("Metrics: socket path too long: {}", listen);
+					return -1;
+				}
+				addr.sun_family = AF_UNIX;
+				std::strncpy(addr.sun_path, listen.c_str(), sizeof(addr.sun_path) - 1);
+				//? Remove a socket left behind by an earlier instance, but never any other kind of file
+				if (struct stat st; lstat(listen.c_str(), &st) == 0 and S_ISSOCK(st.st_mode)) unlink(listen.c_str());
+				fd = socket(AF_UNIX, SOCK_STREAM, 0);
+				if (fd >= 0 and bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 and ::listen(fd, 8) == 0) {
+					socket_path = listen;
+					return fd;
+				}
+			}
+			else {
+				sockaddr_in addr {};
+				addr.sin_family = AF_INET;
+				addr.sin_port = htons(static_cast<uint16_t>(std::stoi(listen)));
+				addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				fd = socket(AF_INET, SOCK_STREAM, 0);
+				const int one = 1;
+				if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+				if (fd >= 0 and bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 and ::listen(fd, 8) == 0)
+					return fd;
+			}
+			Logger::warning("Metrics: failed to listen on {}: {}", listen, strerror(errno));
+			if (fd >= 0) close(fd);
+			return -1;
+		}
+	}
+
+	bool start(const string& listen) {
+		stop();
+		if (listen.empty()) return true;
+
+		listen_fd = open_socket(listen);
+		if (listen_fd < 0) return false;
+		fcntl(listen_fd, F_SETFD, FD_CLOEXEC);
+		if (pipe(wake_pipe.data()) != 0) {
+			Logger::warning("Metrics: failed to create pipe: {}", strerror(errno));
+			stop();
+			return false;
+		}
+		server = std::thread(serve, listen_fd, wake_pipe[0]);
+		listen_addr = listen;
+		Logger::info("Metrics: listening on {}", listen);
+		return true;
+	}
+
+	void stop() {
+		if (server.joinable()) {
+			if (write(wake_pipe[1], "x", 1) < 0) Logger::warning("Metrics: failed to wake server thread: {}", strerror(errno));
+			server.join();
+		}
+		for (auto& fd : wake_pipe) {
+			if (fd >= 0) close(fd);
+			fd = -1;
+		}
+		if (listen_fd >= 0) close(listen_fd);
+		listen_fd = -1;
+		if (not socket_path.empty()) unlink(socket_path.c_str());
+		socket_path.clear();
+		listen_addr.clear();
+	}
+
+	auto listening() -> const string& {
+		return listen_addr;
+	}
+
+	void update(
+		const Cpu::cpu_info* cpu,
+		const Mem::mem_info* mem,
+		const std::unordered_map<string, Net::net_info>* nets,
+	#ifdef GPU_SUPPORT
+		const vector<Gpu::gpu_info>* gpus,
+	#endif
+		const vector<Proc::proc_info>* procs
+	) {
+		if (cpu != nullptr) render_cpu(*cpu);
+		if (mem != nullptr) {
+			if (total_mem == 0) total_mem = Mem::get_totalMem();
+			render_mem(*mem);
+		}
+		if (nets != nullptr) render_net(*nets);
+	#ifdef GPU_SUPPORT
+		if (gpus != nullptr) render_gpus(*gpus);
+	#endif
+		if (procs != nullptr) render_procs(*procs);
+
+		auto next = std::make_shared<string>();
+		next->reserve(cpu_text.size() + mem_text.size() + net_text.size() + gpu_text.size() + proc_text.size());
+		*next += cpu_text;
+		*next += mem_text;
+		*next += net_text;
+		*next += gpu_text;
+		*next += proc_text;
+
+		std::lock_guard lock {snapshot_mtx};
+		current = std::move(next);
+	}
+
+	auto snapshot() -> std::shared_ptr<const string> {
+		std::lock_guard lock {snapshot_mtx};
+		return current;
+	}
+}
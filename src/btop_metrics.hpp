@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "btop_shared.hpp"
+
+//* Prometheus exporter serving the latest collected values on a unix socket or localhost tcp port, enabled with metrics_listen
+namespace Metrics {
+
+	//* Number of processes exported, the ones with the highest cpu usage
+	constexpr size_t top_procs = 10;
+
+	//* Start serving on <listen>, an absolute unix socket path or a tcp port number that is bound to 127.0.0.1.
+	//* Stops any running listener first, an empty <listen> only stops it. Returns false and logs a warning on failure.
+	bool start(const std::string& listen);
+
+	//* Stop the listener and remove its socket file
+	void stop();
+
+	//* The address passed to the last start() call that succeeded, empty when not running
+	auto listening() -> const std::string&;
+
+	//* Replace the exported values of the boxes that were collected, null pointers keep the last values of a box.
+	//* Builds a new snapshot that scrapes pick up without waiting for the runner. Only called from the runner thread.
+	void update(
+		const Cpu::cpu_info* cpu,
+		const Mem::mem_info* mem,
+		const std::unordered_map<std::string, Net::net_info>* nets,
+	#ifdef GPU_SUPPORT
+		const std::vector<Gpu::gpu_info>* gpus,
+	#endif
+		const std::vector<Proc::proc_info>* procs
+	);
+
+	//* The latest snapshot in Prometheus text exposition format
+	auto snapshot() -> std::shared_ptr<const std::string>;
+}
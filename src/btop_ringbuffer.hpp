@@ -0,0 +1,143 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Tools {
+
+	//* Circular buffer over contiguous storage for metric histories, a replacement for deque<long long>.
+	//* Values are stored as <T> to save memory, e.g. uint8_t for percentages, and are read back as long long.
+	//* Values outside the range of <T> are saturated when inserted.
+	//* Storage grows by doubling and is never shrunk, so once a history reaches its trimmed length
+	//* push_back()/pop_front() are O(1) and never allocate.
+	template <std::integral T>
+		requires (sizeof(T) < sizeof(long long) or std::same_as<T, long long>)
+	class RingBuffer {
+		std::vector<T> buf;
+		size_t head = 0;
+		size_t count = 0;
+
+		[[nodiscard]] size_t wrap(size_t pos) const noexcept { return pos & (buf.size() - 1); }
+
+		static T narrow(long long value) noexcept {
+			if constexpr (std::same_as<T, long long>) {
+				return value;
+			}
+			else {
+				return static_cast<T>(std::clamp<long long>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+			}
+		}
+
+		//? Capacity is kept at a power of two so wrapping is a mask
+		void grow() {
+			std::vector<T> next(std::max<size_t>(8, buf.size() * 2));
+			for (size_t i = 0; i < count; i++) next[i] = buf[wrap(head + i)];
+			buf.swap(next);
+			head = 0;
+		}
+
+	public:
+		using value_type = long long;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class const_iterator {
+			const RingBuffer* ring = nullptr;
+			std::ptrdiff_t pos = 0;
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = long long;
+			using difference_type = std::ptrdiff_t;
+			using reference = long long;
+			using pointer = void;
+
+			const_iterator() = default;
+			const_iterator(const RingBuffer* ring, std::ptrdiff_t pos) noexcept : ring(ring), pos(pos) {}
+
+			long long operator*() const noexcept { return (*ring)[pos]; }
+			long long operator[](difference_type n) const noexcept { return (*ring)[pos + n]; }
+
+			const_iterator& operator++() noexcept { ++pos; return *this; }
+			const_iterator operator++(int) noexcept { auto tmp = *this; ++pos; return tmp; }
+			const_iterator& operator--() noexcept { --pos; return *this; }
+			const_iterator operator--(int) noexcept { auto tmp = *this; --pos; return tmp; }
+			const_iterator& operator+=(difference_type n) noexcept { pos += n; return *this; }
+			const_iterator& operator-=(difference_type n) noexcept { pos -= n; return *this; }
+
+			friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+			friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+			friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+			friend difference_type operator-(const const_iterator& a, const const_iterator& b) noexcept { return a.pos - b.pos; }
+
+			friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept { return a.pos == b.pos; }
+			friend auto operator<=>(const const_iterator& a, const const_iterator& b) noexcept { return a.pos <=> b.pos; }
+		};
+		using iterator = const_iterator;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		RingBuffer() = default;
+		RingBuffer(std::initializer_list<long long> values) {
+			for (const auto value : values) push_back(value);
+		}
+
+		[[nodiscard]] size_t size() const noexcept { return count; }
+		[[nodiscard]] bool empty() const noexcept { return count == 0; }
+		[[nodiscard]] size_t capacity() const noexcept { return buf.size(); }
+
+		//* Element <i> counted from the oldest value, unchecked
+		[[nodiscard]] long long operator[](size_t i) const noexcept { return buf[wrap(head + i)]; }
+
+		[[nodiscard]] long long at(size_t i) const {
+			if (i >= count) throw std::out_of_range("RingBuffer::at");
+			return (*this)[i];
+		}
+
+		[[nodiscard]] long long front() const noexcept { return buf[head]; }
+		[[nodiscard]] long long back() const noexcept { return (*this)[count - 1]; }
+
+		void push_back(long long value) {
+			if (count == buf.size()) grow();
+			buf[wrap(head + count++)] = narrow(value);
+		}
+
+		void pop_front() noexcept {
+			head = wrap(head + 1);
+			--count;
+		}
+
+		void clear() noexcept {
+			head = count = 0;
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept { return { this, 0 }; }
+		[[nodiscard]] const_iterator end() const noexcept { return { this, static_cast<difference_type>(count) }; }
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		[[nodiscard]] const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+	};
+
+}
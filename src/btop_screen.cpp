@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_screen.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+#include "widechar_width.hpp"
+
+namespace Screen {
+
+	namespace {
+		//? SGR codes turning the attribute at each bit of Style::attrs on and off, 22 turns off both bold and dim
+		constexpr std::array<int, 8> attr_on { 1, 2, 3, 4, 5, 7, 8, 9 };
+		constexpr std::array<int, 8> attr_off { 22, 22, 23, 24, 25, 27, 28, 29 };
+		constexpr uint16_t bold_dim = 0b11;
+
+		void append_int(std::string& out, int value) {
+			std::array<char, 12> buf;
+			const auto [ptr, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), value);
+			out.append(buf.data(), ptr);
+		}
+
+		//? Parse the ';' or ':' separated numbers in <params> into <values>, returns the count
+		template <size_t N>
+		size_t parse_params(std::string_view params, std::array<int, N>& values) {
+			size_t count = 0;
+			int value = 0;
+			for (const char c : params) {
+				if (c >= '0' and c <= '9') value = value * 10 + (c - '0');
+				else if (c == ';' or c == ':') {
+					if (count < N) values[count++] = value;
+					value = 0;
+				}
+			}
+			if (count < N) values[count++] = value;
+			return count;
+		}
+	}
+
+	void Buffer::reset(int width, int height) {
+		this->width = std::max(width, 0);
+		this->height = std::max(height, 0);
+		back.assign(static_cast<size_t>(this->width) * this->height, Cell{});
+		front = back;
+		dirty_rows.assign(this->height, 0);
+		passthrough.clear();
+		row = col = saved_row = saved_col = 0;
+		style = {};
+		valid = (this->width > 0 and this->height > 0);
+		clear = true;
+	}
+
+	void Buffer::put(std::string_view text, int cell_width) {
+		if (row < 0 or row >= height) return;
+
+		//? Zero width characters like combining marks belong to the previous cell
+		if (cell_width == 0) {
+			if (col == 0 or col > width) return;
+			int pos = row * width + col - 1;
+			if (back[pos].text.empty() and col > 1) pos--;
+			back[pos].text.append(text);
+			dirty_rows[row] = 1;
+			return;
+		}
+
+		//? Text past the right edge is dropped, btop never relies on the terminal wrapping lines
+		if (col + cell_width > width) {
+			col += cell_width;
+			return;
+		}
+
+		//? Overwriting one half of a double width character blanks the other half, as terminals do
+		const int pos = row * width + col;
+		if (back[pos].text.empty() and col > 0) back[pos - 1].text = " ";
+		if (col + cell_width < width and back[pos + cell_width].text.empty()) back[pos + cell_width].text = " ";
+
+		back[pos].text.assign(text);
+		back[pos].style = style;
+		if (cell_width == 2) {
+			back[pos + 1].text.clear();
+			back[pos + 1].style = style;
+		}
+		dirty_rows[row] = 1;
+		col += cell_width;
+	}
+
+	void Buffer::erase(int from, int to) {
+		if (from >= to) return;
+		if (back[from].text.empty() and from % width > 0) back[from - 1].text = " ";
+		if (to < width * height and back[to].text.empty()) back[to].text = " ";
+
+		const Cell blank { " ", Style{ .bg = style.bg } };
+		std::fill(back.begin() + from, back.begin() + to, blank);
+		for (int r = from / width; r <= (to - 1) / width; r++) dirty_rows[r] = 1;
+	}
+
+	void Buffer::sgr(std::string_view params) {
+		std::array<int, 32> values;
+		const size_t count = parse_params(params, values);
+
+		auto color = [&](size_t& i) -> uint32_t {
+			if (i + 2 < count and values[i + 1] == 5) {
+				i += 2;
+				return color_indexed << 24 | (values[i] & 0xff);
+			}
+			if (i + 4 < count and values[i + 1] == 2) {
+				i += 4;
+				return color_rgb << 24 | (values[i - 2] & 0xff) << 16 | (values[i - 1] & 0xff) << 8 | (values[i] & 0xff);
+			}
+			i = count;
+			return color_default;
+		};
+
+		for (size_t i = 0; i < count; i++) {
+			const int code = values[i];
+			if (code == 0) style = {};
+			else if (code >= 30 and code <= 37) style.fg = color_basic << 24 | (code - 30);
+			else if (code >= 90 and code <= 97) style.fg = color_basic << 24 | (code - 90 + 8);
+			else if (code >= 40 and code <= 47) style.bg = color_basic << 24 | (code - 40);
+			else if (code >= 100 and code <= 107) style.bg = color_basic << 24 | (code - 100 + 8);
+			else if (code == 38) style.fg = color(i);
+			else if (code == 48) style.bg = color(i);
+			else if (code == 39) style.fg = color_default;
+			else if (code == 49) style.bg = color_default;
+			else if (code == 22) style.attrs &= ~bold_dim;
+			else {
+				for (size_t bit = 0; bit < attr_on.size(); bit++) {
+					if (code == attr_on[bit]) style.attrs |= 1 << bit;
+					else if (code == attr_off[bit]) style.attrs &= ~(1 << bit);
+				}
+			}
+		}
+	}
+
+	void Buffer::csi(std::string_view params, char final, std::string_view raw) {
+		//? Private sequences like "?25l" change terminal modes and don't affect cells
+		if (not params.empty() and (params.front() < '0' or params.front() > ';')) {
+			passthrough.append(raw);
+			return;
+		}
+		if (final == 'm') {
+			sgr(params);
+			return;
+		}
+
+		std::array<int, 2> values {};
+		parse_params(params, values);
+		const int n = std::max(values[0], 1);
+		const int pos = row * width + std::min(col, width - 1);
+
+		switch (final) {
+			case 'H': case 'f':
+				row = std::clamp(values[0], 1, height) - 1;
+				col = std::clamp(values[1], 1, width) - 1;
+				break;
+			case 'A': row = std::max(row - n, 0); break;
+			case 'B': row = std::min(row + n, height - 1); break;
+			case 'C': col = std::min(col + n, width - 1); break;
+			case 'D': col = std::max(std::min(col, width - 1) - n, 0); break;
+			case 'G': col = std::clamp(values[0], 1, width) - 1; break;
+			case 'd': row = std::clamp(values[0], 1, height) - 1; break;
+			case 's': saved_row = row; saved_col = col; break;
+			case 'u': row = saved_row; col = saved_col; break;
+			case 'J':
+				if (values[0] == 0) erase(pos, width * height);
+				else if (values[0] == 1) erase(0, pos + 1);
+				else erase(0, width * height);
+				break;
+			case 'K':
+				if (values[0] == 0) erase(pos, (row + 1) * width);
+				else if (values[0] == 1) erase(row * width, pos + 1);
+				else erase(row * width, (row + 1) * width);
+				break;
+			case 'X': erase(pos, std::min(pos + n, (row + 1) * width)); break;
+			default: passthrough.append(raw);
+		}
+	}
+
+	void Buffer::write(std::string_view data) {
+		if (not valid) return;
+		size_t i = 0;
+		while (i < data.size()) {
+			const auto c = static_cast<unsigned char>(data[i]);
+
+			if (c == '\x1b') {
+				if (i + 1 >= data.size()) break;
+				if (data[i + 1] == '[') {
+					size_t end = i + 2;
+					while (end < data.size() and (data[end] < 0x40 or data[end] > 0x7e)) end++;
+					if (end >= data.size()) break;
+					csi(data.substr(i + 2, end - i - 2), data[end], data.substr(i, end - i + 1));
+					i = end + 1;
+				}
+				else {
+					if (data[i + 1] == '7') { saved_row = row; saved_col = col; }
+					else if (data[i + 1] == '8') { row = saved_row; col = saved_col; }
+					else passthrough.append(data.substr(i, 2));
+					i += 2;
+				}
+				continue;
+			}
+
+			if (c < 0x20 or c == 0x7f) {
+				switch (c) {
+					case '\n': row = std::min(row + 1, height - 1); col = 0; break;
+					case '\r': col = 0; break;
+					case '\b': col = std::max(std::min(col, width - 1) - 1, 0); break;
+					case '\t': col = std::min((col / 8 + 1) * 8, width - 1); break;
+				}
+				i++;
+				continue;
+			}
+
+			//? Printable text, decoded one UTF-8 character at a time to find its width in cells
+			size_t len = (c < 0xc0) ? 1 : (c < 0xe0) ? 2 : (c < 0xf0) ? 3 : 4;
+			len = std::min(len, data.size() - i);
+			int cell_width = 1;
+			if (len > 1) {
+				uint32_t codepoint = c & (0x7f >> len);
+				for (size_t k = 1; k < len; k++) codepoint = codepoint << 6 | (data[i + k] & 0x3f);
+				cell_width = widechar_wcwidth(codepoint);
+			}
+			put(data.substr(i, len), cell_width);
+			i += len;
+		}
+	}
+
+	void Buffer::move_to(int to_row, int to_col) {
+		if (term_row == to_row and term_col == to_col) return;
+
+		if (term_row == to_row and term_col >= 0 and to_col > term_col and term_col < width) {
+			//? Rewriting up to three unchanged single byte cells is shorter than a cursor move if no style change is needed
+			const int gap = to_col - term_col;
+			const int pos = to_row * width + term_col;
+			if (gap <= 3 and style_known and std::all_of(back.begin() + pos, back.begin() + pos + gap,
+				[&](const Cell& cell) { return cell.text.size() == 1 and cell.style == term_style; })) {
+				for (int i = 0; i < gap; i++) out += back[pos + i].text;
+			}
+			else {
+				out += "\x1b[";
+				append_int(out, gap);
+				out += 'C';
+			}
+		}
+		else {
+			out += "\x1b[";
+			append_int(out, to_row + 1);
+			out += ';';
+			append_int(out, to_col + 1);
+			out += 'H';
+		}
+		term_row = to_row;
+		term_col = to_col;
+	}
+
+	void Buffer::set_style(const Style& next) {
+		if (style_known and next == term_style) return;
+
+		Style from = style_known ? term_style : Style{};
+		bool first = true;
+		auto param = [&](int value) {
+			if (not first) out += ';';
+			append_int(out, value);
+			first = false;
+		};
+		auto color = [&](uint32_t value, int base) {
+			const int index = value & 0xff;
+			switch (value >> 24) {
+				case color_default: param(base + 9); break;
+				case color_basic: param(index < 8 ? base + index : base + 60 + index - 8); break;
+				case color_indexed: param(base + 8); param(5); param(index); break;
+				case color_rgb: param(base + 8); param(2); param((value >> 16) & 0xff); param((value >> 8) & 0xff); param(index); break;
+			}
+		};
+
+		out += "\x1b[";
+		if (not style_known or next == Style{}) {
+			param(0);
+			from = {};
+		}
+		if (const uint16_t removed = from.attrs & ~next.attrs; removed != 0) {
+			//? Bold and dim share an off code, so whichever one remains is turned back on below
+			if (removed & bold_dim) {
+				param(22);
+				from.attrs &= ~bold_dim;
+			}
+			for (size_t bit = 2; bit < attr_off.size(); bit++) {
+				if (removed & (1 << bit)) param(attr_off[bit]);
+			}
+		}
+		for (size_t bit = 0; bit < attr_on.size(); bit++) {
+			if (next.attrs & ~from.attrs & (1 << bit)) param(attr_on[bit]);
+		}
+		if (next.fg != from.fg) color(next.fg, 30);
+		if (next.bg != from.bg) color(next.bg, 40);
+		out += 'm';
+
+		term_style = next;
+		style_known = true;
+	}
+
+	auto Buffer::flush() -> const std::string& {
+		out.clear();
+		if (not valid) return out;
+
+		//? Other output may have moved the cursor or changed the style since the last flush
+		term_row = term_col = -1;
+		style_known = false;
+
+		out += passthrough;
+		passthrough.clear();
+		if (clear) {
+			out += "\x1b[0m\x1b[2J";
+			term_style = {};
+			style_known = true;
+			clear = false;
+		}
+
+		for (int r = 0; r < height; r++) {
+			if (not dirty_rows[r]) continue;
+			dirty_rows[r] = 0;
+
+			for (int c = 0; c < width;) {
+				const int pos = r * width + c;
+				const auto& cell = back[pos];
+				if (cell == front[pos]) {
+					c++;
+					continue;
+				}
+				//? The right half of a double width character is sent together with the left half
+				if (cell.text.empty()) {
+					front[pos] = cell;
+					c++;
+					continue;
+				}
+
+				const int cell_width = (c + 1 < width and back[pos + 1].text.empty()) ? 2 : 1;
+				move_to(r, c);
+				set_style(cell.style);
+				out += cell.text;
+				std::copy(back.begin() + pos, back.begin() + pos + cell_width, front.begin() + pos);
+				term_col += cell_width;
+				c += cell_width;
+			}
+		}
+		return out;
+	}
+
+	void Buffer::commit() {
+		if (not valid) return;
+		passthrough.clear();
+		clear = false;
+		for (int r = 0; r < height; r++) {
+			if (not dirty_rows[r]) continue;
+			dirty_rows[r] = 0;
+			std::copy(back.begin() + r * width, back.begin() + (r + 1) * width, front.begin() + r * width);
+		}
+	}
+
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//* Cell grid mirroring the terminal, used to only send the parts of a frame that changed
+namespace Screen {
+
+	//* Colors and text effects of a cell as set by SGR sequences
+	struct Style {
+		//? Colors are encoded as <kind> << 24 | <value>, see color_kind
+		uint32_t fg{};
+		uint32_t bg{};
+		uint16_t attrs{};
+
+		bool operator==(const Style& other) const = default;
+	};
+
+	enum color_kind : uint32_t { color_default, color_basic, color_indexed, color_rgb };
+
+	struct Cell {
+		//? UTF-8 text of the cell, empty for the right half of a double width character
+		std::string text = " ";
+		Style style;
+
+		bool operator==(const Cell& other) const = default;
+	};
+
+	//* Interprets the cursor movement, erase and SGR sequences written by btop into a back buffer and
+	//* produces the shortest update it can find from the last flushed frame, with cursor moves and style changes between changed runs.
+	//* Sequences it doesn't interpret, like mode changes, are passed through at the start of the next update.
+	class Buffer {
+		int width = 0, height = 0;
+		std::vector<Cell> back, front;
+		std::vector<uint8_t> dirty_rows;
+		std::string passthrough, out;
+		bool valid = false, clear = false;
+
+		//? Parser state
+		int row = 0, col = 0, saved_row = 0, saved_col = 0;
+		Style style;
+
+		//? Terminal state while emitting, -1 and style_known=false when unknown
+		int term_row = -1, term_col = -1;
+		Style term_style;
+		bool style_known = false;
+
+		void put(std::string_view text, int cell_width);
+		void erase(int from, int to);
+		void csi(std::string_view params, char final, std::string_view raw);
+		void sgr(std::string_view params);
+		void move_to(int to_row, int to_col);
+		void set_style(const Style& next);
+
+	public:
+		//* Clear the buffer to <width> x <height>, the next flush() clears the terminal and sends the whole frame
+		void reset(int width, int height);
+
+		//* Stop diffing until the next reset(), for when the terminal was written to without going through the buffer
+		void invalidate() noexcept { valid = false; }
+
+		[[nodiscard]] bool ready(int width, int height) const noexcept {
+			return valid and width == this->width and height == this->height;
+		}
+
+		//* Apply a frame or part of a frame to the back buffer
+		void write(std::string_view data);
+
+		//* Return the bytes needed to bring the terminal up to date with the back buffer, the string is reused between calls
+		auto flush() -> const std::string&;
+
+		//* Mark the back buffer as shown, for when the written data was sent to the terminal as is instead of flushed
+		void commit();
+	};
+
+}
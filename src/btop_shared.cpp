@@ -17,11 +17,14 @@ tab-size = 4
 */
 
 #include <sys/resource.h>
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
 #include <ranges>
 #include <regex>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 
 #include "btop_config.hpp"
@@ -32,8 +35,52 @@ namespace fs = std::filesystem;
 namespace rng = std::ranges;
 using namespace Tools;
 
+namespace Shared {
+	int history_tier() {
+		const auto& zoom = Config::getS("history_zoom");
+		for (size_t i = 0; i < TieredHistory<uint8_t>::tier_names.size(); i++) {
+			if (zoom == TieredHistory<uint8_t>::tier_names[i]) return i;
+		}
+		return -1;
+	}
+
+	template <typename T>
+	auto graph_data(const RingBuffer<T>& live, const std::unordered_map<string, TieredHistory<T>>& history, const string& key) -> const RingBuffer<T>& {
+		const int tier = history_tier();
+		if (tier < 0) return live;
+		const auto it = history.find(key);
+		if (it == history.end()) return live;
+
+		const auto& type = Config::getS("history_consolidation");
+		using consolidation = typename TieredHistory<T>::consolidation;
+		const auto& series = it->second.series(tier, type == "min" ? consolidation::min : type == "max" ? consolidation::max : consolidation::avg);
+		return series.empty() ? live : series;
+	}
+	template auto graph_data(const RingBuffer<uint8_t>&, const std::unordered_map<string, TieredHistory<uint8_t>>&, const string&) -> const RingBuffer<uint8_t>&;
+	template auto graph_data(const RingBuffer<long long>&, const std::unordered_map<string, TieredHistory<long long>>&, const string&) -> const RingBuffer<long long>&;
+}
+
+namespace {
+	//? Add the last value of every history in <live> to <history>, returns true if the tier selected in history_zoom advanced
+	template <typename T>
+	bool record_history(std::unordered_map<string, TieredHistory<T>>& history, const std::unordered_map<string, RingBuffer<T>>& live, const string& prefix = "") {
+		const uint64_t now = time_ms();
+		unsigned advanced = 0;
+		for (const auto& [name, values] : live) {
+			if (not values.empty()) advanced |= history[prefix + name].add(now, values.back());
+		}
+		const int tier = Shared::history_tier();
+		return tier >= 0 and (advanced & (1u << tier)) != 0;
+	}
+}
+
 namespace Cpu {
     std::optional<std::string> container_engine;
+	std::unordered_map<string, TieredHistory<uint8_t>> history;
+
+	bool update_history(const cpu_info& cpu) {
+		return record_history(history, cpu.cpu_percent);
+	}
 
 	string trim_name(string name) {
 		auto name_vec = ssplit(name);
@@ -80,11 +127,29 @@ namespace Cpu {
 	}
 }
 
+namespace Mem {
+	bool collect_disks = true;
+	bool collect_mem = true;
+	std::unordered_map<string, TieredHistory<uint8_t>> history;
+
+	bool update_history(const mem_info& mem) {
+		return record_history(history, mem.percent);
+	}
+}
+
+namespace Net {
+	std::unordered_map<string, TieredHistory<long long>> history;
+
+	bool update_history(const net_info& net) {
+		return record_history(history, net.bandwidth, selected_iface + ':');
+	}
+}
+
 #ifdef GPU_SUPPORT
 namespace Gpu {
 	vector<string> gpu_names;
 	vector<int> gpu_b_height_offsets;
-	std::unordered_map<string, deque<long long>> shared_gpu_percent = {
+	std::unordered_map<string, RingBuffer<uint8_t>> shared_gpu_percent = {
 		{"gpu-average", {}},
 		{"gpu-vram-total", {}},
 		{"gpu-pwr-total", {}},
@@ -101,44 +166,175 @@ bool set_priority(pid_t pid, int priority) {
   return false;
 }
 
+	namespace {
+		template <typename Key>
+		struct sort_entry {
+			Key key;
+			size_t index;
+		};
+
+		//? Stable sort of the rows in <table> by the key <proj> gives for each row, compared with <comp>.
+		//? Sorts packed keys and merges the already ordered runs left by the previous sort,
+		//? so the usual case of a few processes changing place costs little more than one pass to find the runs.
+		template <typename Comp, typename Proj>
+		void adaptive_sort(vector<proc_row>& table, Comp comp, Proj proj) {
+			using Key = std::invoke_result_t<Proj, const proc_row&>;
+			static vector<sort_entry<Key>> entries;
+			static vector<size_t> runs;
+			static vector<proc_row> sorted;
+
+			const size_t count = table.size();
+			if (count < 2) return;
+
+			entries.resize(count);
+			for (size_t i = 0; i < count; i++) entries[i] = { proj(table[i]), i };
+
+			//? Find ascending runs, positions where the order breaks start a new run
+			runs.clear();
+			runs.push_back(0);
+			for (size_t i = 1; i < count; i++) {
+				if (comp(entries[i].key, entries[i - 1].key)) runs.push_back(i);
+			}
+			runs.push_back(count);
+			if (runs.size() == 2) return;
+
+			//? Merge neighbouring runs pairwise until one run is left, std::inplace_merge keeps equal keys in order
+			const auto entry_comp = [&comp](const auto& a, const auto& b) { return comp(a.key, b.key); };
+			const auto first = entries.begin();
+			while (runs.size() > 2) {
+				size_t out = 1;
+				for (size_t k = 0; k + 1 < runs.size(); k += 2) {
+					if (k + 2 < runs.size()) {
+						std::inplace_merge(first + runs[k], first + runs[k + 1], first + runs[k + 2], entry_comp);
+						runs[out++] = runs[k + 2];
+					}
+					else runs[out++] = runs[k + 1];
+				}
+				runs.resize(out);
+			}
+
+			//? Rows are small and trivially copyable, so gather them in the new order
+			sorted.resize(count);
+			for (size_t i = 0; i < count; i++) sorted[i] = table[entries[i].index];
+			table.swap(sorted);
+		}
+
+		//? Sort <table> by the numeric row member <member>
+		template <typename Comp, typename Member>
+		void sort_rows(vector<proc_row>& table, Comp comp, Member proc_row::* member) {
+			adaptive_sort(table, comp, [member](const proc_row& row) { return row.*member; });
+		}
+
+		//? Sort <table> by the string member <member> of the processes in <procs>
+		template <typename Comp>
+		void sort_rows(vector<proc_row>& table, const vector<proc_info>& procs, Comp comp, string proc_info::* member) {
+			adaptive_sort(table, comp, [&procs, member](const proc_row& row) { return std::string_view{procs[row.slot].*member}; });
+		}
+	}
+
+	void fill_table(vector<proc_row>& table, const vector<proc_info>& procs) {
+		table.resize(procs.size());
+		for (size_t i = 0; i < procs.size(); i++) {
+			const auto& p = procs[i];
+			table[i] = {
+				.pid = p.pid,
+				.ppid = p.ppid,
+				.mem = p.mem,
+				.cpu_p = p.cpu_p,
+				.cpu_c = p.cpu_c,
+				.threads = static_cast<uint32_t>(p.threads),
+				.slot = static_cast<uint32_t>(i),
+				.depth = static_cast<uint32_t>(p.depth),
+				.tree_index = static_cast<uint32_t>(p.tree_index),
+				.state = p.state,
+				.collapsed = p.collapsed,
+				.filtered = p.filtered,
+			};
+		}
+	}
+
+	void apply_table(vector<proc_row>& table, vector<proc_info>& procs) {
+		//? Apply the permutation by following its cycles, moving every struct at most once.
+		//? The cycles are followed over a compact copy of the slots, since walking the rows themselves would touch a cache line per step.
+		static vector<uint32_t> slots;
+		slots.resize(table.size());
+		for (size_t i = 0; i < table.size(); i++) slots[i] = table[i].slot;
+		for (size_t i = 0; i < slots.size(); i++) {
+			if (slots[i] == i) continue;
+			proc_info tmp = std::move(procs[i]);
+			size_t j = i;
+			while (slots[j] != i) {
+				const size_t next = slots[j];
+				procs[j] = std::move(procs[next]);
+				slots[j] = j;
+				j = next;
+			}
+			procs[j] = std::move(tmp);
+			slots[j] = j;
+		}
+
+		//? Rows and processes now line up, so the fields are written back in one sequential pass
+		for (size_t i = 0; i < table.size(); i++) {
+			auto& row = table[i];
+			auto& p = procs[i];
+			row.slot = i;
+			p.ppid = row.ppid;
+			p.mem = row.mem;
+			p.cpu_p = row.cpu_p;
+			p.cpu_c = row.cpu_c;
+			p.threads = row.threads;
+			p.depth = row.depth;
+			p.tree_index = row.tree_index;
+			p.collapsed = row.collapsed;
+			p.filtered = row.filtered;
+		}
+	}
+
 	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree) {
+		static vector<proc_row> table;
+		fill_table(table, proc_vec);
+		proc_sorter(table, proc_vec, sorting, reverse, tree);
+		apply_table(table, proc_vec);
+	}
+
+	void proc_sorter(vector<proc_row>& table, const vector<proc_info>& procs, const string& sorting, bool reverse, bool tree) {
 		if (reverse) {
 			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::less{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::less{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::user); 		break;
-			case 5: rng::stable_sort(proc_vec, rng::less{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_p);		break;
-			case 7: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_c);		break;
+			case 0: sort_rows(table, rng::less{}, &proc_row::pid); 		break;
+			case 1: sort_rows(table, procs, rng::greater{}, &proc_info::name);		break;
+			case 2: sort_rows(table, procs, rng::greater{}, &proc_info::cmd); 		break;
+			case 3: sort_rows(table, rng::less{}, &proc_row::threads);	break;
+			case 4: sort_rows(table, procs, rng::greater{}, &proc_info::user); 		break;
+			case 5: sort_rows(table, rng::less{}, &proc_row::mem); 		break;
+			case 6: sort_rows(table, rng::less{}, &proc_row::cpu_p);		break;
+			case 7: sort_rows(table, rng::less{}, &proc_row::cpu_c);		break;
 			}
 		}
 		else {
 			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::less{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::less{}, &proc_info::user);		break;
-			case 5: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_p);   	break;
-			case 7: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_c);   	break;
+			case 0: sort_rows(table, rng::greater{}, &proc_row::pid); 		break;
+			case 1: sort_rows(table, procs, rng::less{}, &proc_info::name);		break;
+			case 2: sort_rows(table, procs, rng::less{}, &proc_info::cmd); 		break;
+			case 3: sort_rows(table, rng::greater{}, &proc_row::threads);	break;
+			case 4: sort_rows(table, procs, rng::less{}, &proc_info::user);		break;
+			case 5: sort_rows(table, rng::greater{}, &proc_row::mem); 		break;
+			case 6: sort_rows(table, rng::greater{}, &proc_row::cpu_p);   	break;
+			case 7: sort_rows(table, rng::greater{}, &proc_row::cpu_c);   	break;
 			}
 		}
 
 		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
 		if (not tree and not reverse and sorting == "cpu lazy") {
 			double max = 10.0, target = 30.0;
-			for (size_t i = 0, x = 0, offset = 0; i < proc_vec.size(); i++) {
-				if (i <= 5 and proc_vec.at(i).cpu_p > max)
-					max = proc_vec.at(i).cpu_p;
+			for (size_t i = 0, x = 0, offset = 0; i < table.size(); i++) {
+				if (i <= 5 and table.at(i).cpu_p > max)
+					max = table.at(i).cpu_p;
 				else if (i == 6)
 					target = (max > 30.0) ? max : 10.0;
-				if (i == offset and proc_vec.at(i).cpu_p > 30.0)
+				if (i == offset and table.at(i).cpu_p > 30.0)
 					offset++;
-				else if (proc_vec.at(i).cpu_p > target) {
-					rotate(proc_vec.begin() + offset, proc_vec.begin() + i, proc_vec.begin() + i + 1);
+				else if (table.at(i).cpu_p > target) {
+					rotate(table.begin() + offset, table.begin() + i, table.begin() + i + 1);
 					if (++x > 10) break;
 				}
 			}
@@ -168,38 +364,105 @@ bool set_priority(pid_t pid, int priority) {
 		for (auto& r : proc_vec) {
 			r.entry.get().tree_index = (collapsed or r.entry.get().filtered ? index_max : c_index++);
 			if (not r.children.empty()) {
-				tree_sort(r.children, sorting, reverse, paused, c_index, (collapsed or r.entry.get().collapsed or r.entry.get().tree_index == (size_t)index_max));
+				tree_sort(r.children, sorting, reverse, paused, c_index, (collapsed or r.entry.get().collapsed or r.entry.get().tree_index == (uint32_t)index_max));
 			}
 		}
 	}
 
-	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool {
-		if (filter.starts_with("!")) {
-			if (filter.size() == 1) {
-				return true;
+	namespace {
+		//? Lowercase lookup table used to fold case of both needle and haystack the same way
+		const auto fold_table = [] {
+			array<char, 256> table;
+			for (int i = 0; i < 256; i++) table[i] = static_cast<char>(std::tolower(i));
+			return table;
+		}();
+
+		inline char fold(char c) {
+			return fold_table[static_cast<unsigned char>(c)];
+		}
+
+		//? Case-insensitive search for an already lowercased needle
+		bool contains_folded(std::string_view haystack, std::string_view needle) {
+			if (needle.size() > haystack.size()) return false;
+			const char first = needle.front();
+			const size_t last_start = haystack.size() - needle.size();
+			for (size_t i = 0; i <= last_start; i++) {
+				if (fold(haystack[i]) != first) continue;
+				size_t j = 1;
+				while (j < needle.size() and fold(haystack[i + j]) == needle[j]) j++;
+				if (j == needle.size()) return true;
 			}
+			return false;
+		}
+
+		inline auto pid_chars(size_t pid, array<char, 24>& buf) -> std::string_view {
+			const auto result = std::to_chars(buf.data(), buf.data() + buf.size(), pid);
+			return { buf.data(), result.ptr };
+		}
+	}
+
+	CompiledFilter::CompiledFilter(const string& filter) : source(filter) {
+		if (filter.starts_with("!")) {
+			is_regex = true;
+			if (filter.size() == 1) return;
 
 			// An incomplete regex throws, see issue https://github.com/aristocratos/btop/issues/1133
 			try {
-				std::regex regex { filter.substr(1), std::regex::extended };
-				return std::regex_search(std::to_string(proc.pid), regex) || std::regex_search(proc.name, regex) ||
-							 std::regex_match(proc.cmd, regex) || std::regex_search(proc.user, regex);
+				regex.emplace(filter.substr(1), std::regex::extended | std::regex::optimize);
 			} catch (std::regex_error& /* unused */) {
-				return false;
+				regex.reset();
 			}
+			return;
+		}
+
+		needle.resize(filter.size());
+		rng::transform(filter, needle.begin(), fold);
+		numeric = not needle.empty() and rng::all_of(needle, [](char c) { return c >= '0' and c <= '9'; });
+	}
+
+	bool CompiledFilter::matches(const proc_info& proc) const {
+		array<char, 24> pid_buf;
+		if (is_regex) {
+			//? A lone "!" matches everything, an invalid regex matches nothing
+			if (source.size() == 1) return true;
+			if (not regex.has_value()) return false;
+			const auto pid_str = pid_chars(proc.pid, pid_buf);
+			return std::regex_search(pid_str.begin(), pid_str.end(), *regex) or std::regex_search(proc.name, *regex)
+				or std::regex_match(proc.cmd, *regex) or std::regex_search(proc.user, *regex);
 		}
 
-		return std::to_string(proc.pid).contains(filter) || s_contains_ic(proc.name, filter) ||
-					 s_contains_ic(proc.cmd, filter) || s_contains_ic(proc.user, filter);
+		//? An empty filter matches every pid
+		if (needle.empty()) return true;
+		if (numeric and pid_chars(proc.pid, pid_buf).contains(needle)) return true;
+		return contains_folded(proc.name, needle) or contains_folded(proc.cmd, needle) or contains_folded(proc.user, needle);
 	}
 
-	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
-		int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter) {
+	auto get_compiled_filter(const string& filter) -> const CompiledFilter& {
+		static CompiledFilter compiled;
+		if (compiled.str() != filter) compiled = CompiledFilter(filter);
+		return compiled;
+	}
+
+	auto matches_filter(const proc_info& proc, const CompiledFilter& filter) -> bool {
+		return filter.matches(proc);
+	}
+
+	void set_short_cmd(proc_info& proc) {
+		if (proc.short_cmd.empty() and not proc.cmd.empty()) {
+			std::string_view cmd_view = proc.cmd;
+			cmd_view = cmd_view.substr((size_t)0, std::min(cmd_view.find(' '), cmd_view.size()));
+			cmd_view = cmd_view.substr(std::min(cmd_view.find_last_of('/') + 1, cmd_view.size()));
+			proc.short_cmd = string{cmd_view};
+		}
+	}
+
+	void _tree_gen(proc_row& cur_proc, vector<proc_row>& in_procs, vector<proc_info>& procs, vector<tree_proc>& out_procs,
+		int cur_depth, bool collapsed, const CompiledFilter& filter, bool found, bool no_update, bool should_filter) {
 		bool filtering = false;
 
 		//? If filtering, include children of matching processes
 		if (not found and (should_filter or not filter.empty())) {
-			if (!matches_filter(cur_proc, filter)) {
+			if (!matches_filter(procs[cur_proc.slot], filter)) {
 				filtering = true;
 				cur_proc.filtered = true;
 				filter_found++;
@@ -219,24 +482,19 @@ bool set_priority(pid_t pid, int priority) {
 			cur_proc.tree_index = out_procs.size() - 1;
 
 			//? Try to find name of the binary file and append to program name if not the same
-			if (cur_proc.short_cmd.empty() and not cur_proc.cmd.empty()) {
-				std::string_view cmd_view = cur_proc.cmd;
-				cmd_view = cmd_view.substr((size_t)0, std::min(cmd_view.find(' '), cmd_view.size()));
-				cmd_view = cmd_view.substr(std::min(cmd_view.find_last_of('/') + 1, cmd_view.size()));
-				cur_proc.short_cmd = string{cmd_view};
-			}
+			set_short_cmd(procs[cur_proc.slot]);
 		}
 		else {
 			cur_proc.tree_index = in_procs.size();
 		}
 
 		//? Recursive iteration over all children
-		for (auto& p : rng::equal_range(in_procs, cur_proc.pid, rng::less{}, &proc_info::ppid)) {
+		for (auto& p : rng::equal_range(in_procs, cur_proc.pid, rng::less{}, &proc_row::ppid)) {
 			if (collapsed and not filtering) {
 				cur_proc.filtered = true;
 			}
 
-			_tree_gen(p, in_procs, out_procs.back().children, cur_depth + 1, (collapsed or cur_proc.collapsed), filter, found, no_update, should_filter);
+			_tree_gen(p, in_procs, procs, out_procs.back().children, cur_depth + 1, (collapsed or cur_proc.collapsed), filter, found, no_update, should_filter);
 
 			if (not no_update and not filtering and (collapsed or cur_proc.collapsed)) {
 				//auto& parent = cur_proc;
@@ -258,52 +516,53 @@ bool set_priority(pid_t pid, int priority) {
 		}
 	}
 
-	void _collect_prefixes(tree_proc &t, const bool is_last, const string &header) {
+	void _collect_prefixes(tree_proc &t, vector<proc_info>& procs, const bool is_last, const string &header) {
 		const bool is_filtered = t.entry.get().filtered;
 		if (is_filtered) t.entry.get().depth = 0;
 
-		if (!t.children.empty()) t.entry.get().prefix = header + (t.entry.get().collapsed ? "[+]─": "[-]─");
-		else t.entry.get().prefix = header + (is_last ? " └─": " ├─");
+		auto& prefix = procs[t.entry.get().slot].prefix;
+		if (!t.children.empty()) prefix = header + (t.entry.get().collapsed ? "[+]─": "[-]─");
+		else prefix = header + (is_last ? " └─": " ├─");
 
 		for (auto child = t.children.begin(); child != t.children.end(); ++child) {
-			_collect_prefixes(*child, child == (t.children.end() - 1),
+			_collect_prefixes(*child, procs, child == (t.children.end() - 1),
 				is_filtered ? "": header + (is_last ? "   ": " │ "));
 		}
 	}
 
-	void toggle_tree_collapse(std::vector<proc_info>& current_procs) {
+	void toggle_tree_collapse(std::vector<proc_row>& table) {
 		//? Build sets of all pids and parent pids to identify root processes
 		std::unordered_set<size_t> pid_set, parent_pids;
-		for (const auto& p : current_procs) {
+		for (const auto& p : table) {
 			pid_set.insert(p.pid);
 			parent_pids.insert(static_cast<size_t>(p.ppid));
 		}
 		//? If any non-root parent is expanded, collapse; otherwise expand
-		const bool do_collapse = rng::any_of(current_procs, [&parent_pids, &pid_set](const proc_info& p) {
+		const bool do_collapse = rng::any_of(table, [&parent_pids, &pid_set](const proc_row& p) {
 			return parent_pids.contains(p.pid)
 				and pid_set.contains(static_cast<size_t>(p.ppid))
 				and not p.collapsed;
 		});
 		//? Root processes (parent not in tracked list) are never touched
-		for (auto& p : current_procs) {
+		for (auto& p : table) {
 			if (not pid_set.contains(static_cast<size_t>(p.ppid))) continue;
 			p.collapsed = do_collapse;
 		}
 	}
 
-	void _auto_collapse_oversized(std::vector<proc_info>& current_procs, const bool tree_mode_change) {
+	void _auto_collapse_oversized(std::vector<proc_row>& table, const bool tree_mode_change) {
 		//? Only act when the user just switched into tree view
 		const int threshold = Config::getI("proc_tree_auto_collapse");
 		if (threshold <= 0 or not tree_mode_change) return;
 		//? Never collapse the root process or its direct children, only deeper busy parents
-		const size_t root_ppid = static_cast<size_t>(current_procs.at(0).ppid);
+		const size_t root_ppid = static_cast<size_t>(table.at(0).ppid);
 		std::unordered_set<size_t> root_pids;
-		for (const auto& p : current_procs) {
+		for (const auto& p : table) {
 			if (static_cast<size_t>(p.ppid) == root_ppid) root_pids.insert(p.pid);
 		}
-		for (auto& p : current_procs) {
+		for (auto& p : table) {
 			if (static_cast<size_t>(p.ppid) == root_ppid or root_pids.contains(static_cast<size_t>(p.ppid))) continue;
-			if (rng::count(current_procs, p.pid, &proc_info::ppid) >= threshold) {
+			if (rng::count(table, p.pid, &proc_row::ppid) >= threshold) {
 				p.collapsed = true;
 			}
 		}
@@ -24,6 +24,7 @@ tab-size = 4
 #include <deque>
 #include <filesystem>
 #include <optional>
+#include <regex>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -32,6 +33,9 @@ tab-size = 4
 
 #include <unistd.h>
 
+#include "btop_history.hpp"
+#include "btop_ringbuffer.hpp"
+
 // From `man 3 getifaddrs`: <net/if.h> must be included before <ifaddrs.h>
 // clang-format off
 #include <net/if.h>
@@ -48,6 +52,8 @@ using std::deque;
 using std::string;
 using std::tuple;
 using std::vector;
+using Tools::RingBuffer;
+using Tools::TieredHistory;
 
 using namespace std::literals; // for operator""s
 
@@ -85,6 +91,16 @@ namespace Runner {
 
 	void run(const string& box = "", bool no_update = false, bool force_redraw = false);
 	void stop();
+
+	//* Update interval in ms of <box> ("cpu", "mem", "disks", "net", "proc" or "gpu") from update_ms_<box>, or update_ms if not set
+	uint64_t box_update_ms(const string& box);
+
+	//* Interval of the main loop, the shortest update interval of the shown boxes
+	uint64_t tick_ms();
+
+	//* Set named counter shown below the timings in the debug overlay, does nothing unless running with --debug.
+	//* Safe to call from any thread.
+	void debug_stat(const string& name, uint64_t value);
 }
 
 namespace Tools {
@@ -98,6 +114,14 @@ namespace Shared {
 
 	extern long coreCount, page_size, clk_tck;
 
+	//* Index of the TieredHistory tier selected with the history_zoom option, -1 when graphs show live samples
+	int history_tier();
+
+	//* Return the history of <key> for the zoom level and consolidation selected in the config,
+	//* or <live> when not zoomed out or no history exists for <key>
+	template <typename T>
+	auto graph_data(const RingBuffer<T>& live, const std::unordered_map<string, TieredHistory<T>>& history, const string& key) -> const RingBuffer<T>&;
+
 #if defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
 	struct KvmDeleter {
 		void operator()(kvm_t* handle) {
@@ -122,7 +146,7 @@ namespace Gpu {
 	extern vector<int> gpu_b_height_offsets;
 	extern long long gpu_pwr_total_max;
 
-	extern std::unordered_map<string, deque<long long>> shared_gpu_percent; // averages, power/vram total
+	extern std::unordered_map<string, RingBuffer<uint8_t>> shared_gpu_percent; // averages, power/vram total
 
 	extern const array<string, 2> mem_names;
 
@@ -150,7 +174,7 @@ namespace Gpu {
 
 	//* Per-device container for GPU info
 	struct gpu_info {
-		std::unordered_map<string, deque<long long>> gpu_percent = {
+		std::unordered_map<string, RingBuffer<uint8_t>> gpu_percent = {
 			{"gpu-totals", {}},
 			{"gpu-vram-totals", {}},
 			{"gpu-pwr-totals", {}},
@@ -161,12 +185,12 @@ namespace Gpu {
 		long long pwr_max_usage = 255000;
 		long long pwr_state;
 
-		deque<long long> temp = {0};
+		RingBuffer<int16_t> temp = {0};
 		long long temp_max = 110;
 
 		long long mem_total = 0;
 		long long mem_used = 0;
-		deque<long long> mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
+		RingBuffer<uint8_t> mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
 		long long mem_clock_speed = 0; // MHz
 
 		long long pcie_tx = 0; // KB/s
@@ -216,7 +240,7 @@ namespace Cpu {
 	extern std::optional<std::string> container_engine;
 
 	struct cpu_info {
-		std::unordered_map<string, deque<long long>> cpu_percent = {
+		std::unordered_map<string, RingBuffer<uint8_t>> cpu_percent = {
 			{"total", {}},
 			{"user", {}},
 			{"nice", {}},
@@ -229,8 +253,8 @@ namespace Cpu {
 			{"guest", {}},
 			{"guest_nice", {}}
 		};
-		vector<deque<long long>> core_percent;
-		vector<deque<long long>> temp;
+		vector<RingBuffer<uint8_t>> core_percent;
+		vector<RingBuffer<int16_t>> temp;
 		long long temp_max = 0;
 		array<double, 3> load_avg;
 		float usage_watts = 0;
@@ -240,6 +264,12 @@ namespace Cpu {
 	//* Collect cpu stats and temperatures
 	auto collect(bool no_update = false) -> cpu_info&;
 
+	//* Long term history of the cpu_percent fields
+	extern std::unordered_map<string, TieredHistory<uint8_t>> history;
+
+	//* Add the latest values in <cpu> to the history, returns true if the selected history tier completed a step
+	bool update_history(const cpu_info& cpu);
+
 	//* Draw contents of cpu box using <cpu> as source
     string draw(
 		const cpu_info& cpu,
@@ -268,8 +298,18 @@ namespace Mem {
 	extern bool has_swap, shown, redraw;
 	const array mem_names { "used"s, "available"s, "cached"s, "free"s };
 	const array swap_names { "swap_used"s, "swap_free"s };
+
+	//* Optional memory fields, only collected on Linux. Hugepages is the size of the allocated huge pages.
+	enum extended_field : uint8_t { dirty, writeback, shmem, slab, hugepages, committed, extended_count };
+	const array<string, extended_count> extended_names { "dirty"s, "writeback"s, "shmem"s, "slab"s, "hugepages"s, "committed"s };
 	extern int disk_ios;
 
+	//* Disks are only collected when set, cleared by the runner when disks aren't due for an update yet
+	extern bool collect_disks;
+
+	//* Memory values are only collected when set, cleared by the runner when only disks are due for an update
+	extern bool collect_mem;
+
 	struct disk_info {
 		std::filesystem::path dev;
 		string name;
@@ -282,18 +322,31 @@ namespace Mem {
 		int free_percent{};
 
 		array<int64_t, 3> old_io = {0, 0, 0};
-		deque<long long> io_read = {};
-		deque<long long> io_write = {};
-		deque<long long> io_activity = {};
+		RingBuffer<long long> io_read = {};
+		RingBuffer<long long> io_write = {};
+		RingBuffer<uint8_t> io_activity = {};
+
+		//? Linux only: operations per second and milliseconds spent in the device queue per second at the last collect
+		int64_t read_ops{};
+		int64_t write_ops{};
+		int64_t queue_ms{};
+		//? Linux only: average time per completed request (await) in 1/100 ms and average requests in flight in 1/100
+		RingBuffer<long long> io_await = {};
+		RingBuffer<long long> io_queue = {};
+		array<uint64_t, 4> old_ops = {0, 0, 0, 0};
+		string stat_name{};             // device name in /proc/diskstats
+		size_t stat_index{};            // position of the device in /proc/diskstats at the last lookup
 	};
 
 	struct mem_info {
 		std::unordered_map<string, uint64_t> stats =
 			{{"used", 0}, {"available", 0}, {"cached", 0}, {"free", 0},
 			{"swap_total", 0}, {"swap_used", 0}, {"swap_free", 0}};
-		std::unordered_map<string, deque<long long>> percent =
+		std::unordered_map<string, RingBuffer<uint8_t>> percent =
 			{{"used", {}}, {"available", {}}, {"cached", {}}, {"free", {}},
 			{"swap_total", {}}, {"swap_used", {}}, {"swap_free", {}}};
+		array<uint64_t, extended_count> extended{}; //? Bytes, indexed by extended_field
+		uint32_t extended_valid{};                  //? Bit for each extended field the system reported
 		std::unordered_map<string, disk_info> disks;
 		vector<string> disks_order;
 	};
@@ -304,6 +357,12 @@ namespace Mem {
 	//* Collect mem & disks stats
 	auto collect(bool no_update = false) -> mem_info&;
 
+	//* Long term history of the mem percent fields
+	extern std::unordered_map<string, TieredHistory<uint8_t>> history;
+
+	//* Add the latest values in <mem> to the history, returns true if the selected history tier completed a step
+	bool update_history(const mem_info& mem);
+
 	//* Draw contents of mem box using <mem> as source
 	string draw(const mem_info& mem, bool force_redraw = false, bool data_same = false);
 
@@ -328,7 +387,7 @@ namespace Net {
 	};
 
 	struct net_info {
-		std::unordered_map<string, deque<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
+		std::unordered_map<string, RingBuffer<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
 		std::unordered_map<string, net_stat> stat = { {"download", {}}, {"upload", {}} };
 		string ipv4{};      // defaults to ""
 		string ipv6{};      // defaults to ""
@@ -355,6 +414,12 @@ namespace Net {
 	//* Collect net upload/download stats
 	auto collect(bool no_update=false) -> net_info&;
 
+	//* Long term history of bandwidth, keyed by "<interface>:<download|upload>"
+	extern std::unordered_map<string, TieredHistory<long long>> history;
+
+	//* Add the latest values in <net> for the selected interface to the history, returns true if the selected history tier completed a step
+	bool update_history(const net_info& net);
+
 	//* Draw contents of net box using <net> as source
 	string draw(const net_info& net, bool force_redraw = false, bool data_same = false);
 }
@@ -385,7 +450,6 @@ namespace Proc {
 		string cmd{};           // defaults to ""
 		string short_cmd{};     // defaults to ""
 		size_t threads{};
-		int name_offset{};
 		string user{};          // defaults to ""
 		uint64_t mem{};
 		double cpu_p{};         // defaults to = 0.0
@@ -396,6 +460,7 @@ namespace Proc {
 		uint64_t cpu_s{};
 		uint64_t cpu_t{};
 		uint64_t death_time{};
+		uint64_t generation{};  // collection pass the process was last seen in
 		string prefix{};        // defaults to ""
 		size_t depth{};
 		size_t tree_index{};
@@ -410,15 +475,16 @@ namespace Proc {
 		proc_info entry;
 		string elapsed, parent, status, io_read, io_write, memory;
 		long long first_mem = -1;
-		deque<long long> cpu_percent;
-		deque<long long> mem_bytes;
+		RingBuffer<uint8_t> cpu_percent;
+		RingBuffer<long long> mem_bytes;
 	};
 
 	//? Contains all info for proc detailed box
 	extern detail_container detailed;
 
-	//* Collect and sort process information from /proc
-	auto collect(bool no_update = false) -> vector<proc_info>&;
+	//* Collect and sort process information from /proc.
+	//* <core_count> scales per process cpu usage, the runner passes a copy taken before Cpu::collect() can change Shared::coreCount concurrently
+	auto collect(bool no_update = false, long core_count = Shared::coreCount) -> vector<proc_info>&;
 
 	//* Update current selection and view, returns -1 if no change otherwise the current selection
 	int selection(const std::string_view cmd_key);
@@ -426,36 +492,88 @@ namespace Proc {
 	//* Draw contents of proc box using <plist> as data source
 	string draw(const vector<proc_info>& plist, bool force_redraw = false, bool data_same = false);
 
+	//* Packed copy of the proc_info fields the filter, sort and tree passes read and write, a row fits in one 64 byte cache line.
+	//* Rows are keyed by <slot>, the index of the process in the vector<proc_info> the table was filled from,
+	//* which stays the side store for names, commands, users and prefixes.
+	struct proc_row {
+		size_t pid{};
+		uint64_t ppid{};
+		uint64_t mem{};
+		double cpu_p{};
+		double cpu_c{};
+		uint32_t threads{};
+		uint32_t slot{};
+		uint32_t depth{};
+		uint32_t tree_index{};
+		char state = '0';
+		bool collapsed{};
+		bool filtered{};
+	};
+	static_assert(sizeof(proc_row) <= 64);
+
 	struct tree_proc {
-		std::reference_wrapper<proc_info> entry;
+		std::reference_wrapper<proc_row> entry;
 		vector<tree_proc> children;
 	};
 
 	//* Change priority (nice) of pid, returns true on success otherwise false
 	bool set_priority(pid_t pid, int priority);
 
+	//* Fill <table> with one row for every process in <procs>, the row of procs[i] gets slot i
+	void fill_table(vector<proc_row>& table, const vector<proc_info>& procs);
+
+	//* Write the row fields back to <procs> and move every process to the position of its row, <table> is then keyed by the new positions
+	void apply_table(vector<proc_row>& table, vector<proc_info>& procs);
+
 	//* Sort vector of proc_info's
 	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false);
 
+	//* Sort the rows of <table>, names, commands and users are read from <procs> through the row slots
+	void proc_sorter(vector<proc_row>& table, const vector<proc_info>& procs, const string& sorting, bool reverse, bool tree = false);
+
 	//* Recursive sort of process tree
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, bool paused,
 					int& c_index, const int index_max, bool collapsed = false);
 
-	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool;
+	//* Process filter compiled once from the proc_filter string and reused for every process until the filter changes.
+	//* A filter starting with "!" is an extended regex, otherwise a case-insensitive substring match against pid, name, command and user.
+	class CompiledFilter {
+		string source;
+		string needle;
+		std::optional<std::regex> regex;
+		bool is_regex{};
+		bool numeric{};
+
+	public:
+		CompiledFilter() = default;
+		explicit CompiledFilter(const string& filter);
+
+		[[nodiscard]] bool matches(const proc_info& proc) const;
+		[[nodiscard]] bool empty() const noexcept { return source.empty(); }
+		[[nodiscard]] auto str() const noexcept -> const string& { return source; }
+	};
+
+	//* Return compiled filter for <filter>, only recompiled when <filter> differs from the previous call
+	auto get_compiled_filter(const string& filter) -> const CompiledFilter&;
+
+	auto matches_filter(const proc_info& proc, const CompiledFilter& filter) -> bool;
+
+	//* Set short_cmd to the file name of the binary in cmd if not already set
+	void set_short_cmd(proc_info& proc);
 
-	//* Generate process tree list
-	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
-				   int cur_depth, bool collapsed, const string& filter,
+	//* Generate process tree list from the rows of <in_procs> sorted by ppid, filter matching and short commands use <procs>
+	void _tree_gen(proc_row& cur_proc, vector<proc_row>& in_procs, vector<proc_info>& procs, vector<tree_proc>& out_procs,
+				   int cur_depth, bool collapsed, const CompiledFilter& filter,
 				   bool found = false, bool no_update = false, bool should_filter = false);
 
-	//* Build prefixes for tree view
-	void _collect_prefixes(tree_proc& t, bool is_last, const string &header = "");
+	//* Build prefixes for tree view into <procs>
+	void _collect_prefixes(tree_proc& t, vector<proc_info>& procs, bool is_last, const string &header = "");
 
 	//* Toggle collapse/expand of all tree entries
-	void toggle_tree_collapse(std::vector<proc_info>& current_procs);
+	void toggle_tree_collapse(std::vector<proc_row>& table);
 
 	//* Auto-collapse processes with many direct children when entering tree mode
-	void _auto_collapse_oversized(std::vector<proc_info>& current_procs, const bool tree_mode_change);
+	void _auto_collapse_oversized(std::vector<proc_row>& table, const bool tree_mode_change);
 }
 
 /// Detect container engine.
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_statvfs.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <pthread.h>
+#include <sys/statvfs.h>
+
+#include "btop_log.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+using Tools::time_ms;
+
+namespace Statvfs {
+
+	namespace {
+		//? Workers stuck in statvfs() that get a replacement, mountpoints timing out beyond this wait for a worker to return
+		constexpr size_t max_stuck = 16;
+
+		//? Mountpoints that aren't requested for this long are forgotten, mounts come and go with containers
+		constexpr uint64_t forget_ms = 60'000;
+
+		struct mount {
+			bool queued{};
+			bool running{};
+			//? The running call passed the timeout, its worker is counted as stuck until it returns
+			bool late{};
+			uint64_t started{};
+			uint64_t last_request{};
+			//? No new requests before this time
+			uint64_t retry{};
+			//? Consecutive timeouts, reset by a call that returns in time
+			int timeouts{};
+			std::optional<result> done;
+		};
+	}
+
+	struct pool_state {
+		std::mutex mtx;
+		std::condition_variable cv;
+		std::deque<string> queue;
+		std::unordered_map<string, mount> mounts;
+		size_t threads;
+		size_t live{};
+		size_t stuck{};
+		bool stopping{};
+		uint64_t timeout_ms;
+		uint64_t backoff_ms;
+		uint64_t max_backoff_ms;
+		Pool::query_func func;
+	};
+
+	namespace {
+		void work(std::shared_ptr<pool_state> s) {
+			//? Signals are handled by the main thread
+			sigset_t mask;
+			sigfillset(&mask);
+			pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+			std::unique_lock lock {s->mtx};
+			for (;;) {
+				s->cv.wait(lock, [&] { return s->stopping or not s->queue.empty(); });
+				if (s->stopping) break;
+				const string mountpoint = std::move(s->queue.front());
+				s->queue.pop_front();
+				{
+					auto& m = s->mounts[mountpoint];
+					m.queued = false;
+					m.running = true;
+					m.started = time_ms();
+				}
+
+				lock.unlock();
+				result res;
+				try {
+					res = s->func(mountpoint);
+				}
+				catch (const std::exception& e) {
+					Logger::warning("Statvfs: query for \"{}\" failed: {}", mountpoint, e.what());
+					res.error = EIO;
+				}
+				lock.lock();
+
+				auto& m = s->mounts[mountpoint];
+				m.running = false;
+				m.done = res;
+				if (m.late) {
+					m.late = false;
+					s->stuck--;
+				}
+				else m.timeouts = 0;
+				//? A replacement was started while this worker was stuck
+				if (s->live - s->stuck > s->threads) break;
+			}
+			s->live--;
+		}
+
+		//? Called with the mutex held
+		void spawn(const std::shared_ptr<pool_state>& s) {
+			std::thread(work, s).detach();
+			s->live++;
+		}
+	}
+
+	auto query(const string& mountpoint) -> result {
+		struct statvfs vfs;
+		if (statvfs(mountpoint.c_str(), &vfs) < 0) return { .error = errno };
+		return {
+			.total = static_cast<uint64_t>(vfs.f_blocks) * vfs.f_frsize,
+			.free = static_cast<uint64_t>(vfs.f_bfree) * vfs.f_frsize,
+			.avail = static_cast<uint64_t>(vfs.f_bavail) * vfs.f_frsize,
+		};
+	}
+
+	Pool::Pool(size_t threads, uint64_t timeout_ms, uint64_t backoff_ms, uint64_t max_backoff_ms, query_func func)
+		: state(std::make_shared<pool_state>()) {
+		state->threads = std::max<size_t>(threads, 1);
+		state->timeout_ms = timeout_ms;
+		state->backoff_ms = backoff_ms;
+		state->max_backoff_ms = std::max(max_backoff_ms, backoff_ms);
+		state->func = std::move(func);
+		std::lock_guard lock {state->mtx};
+		for (size_t i = 0; i < state->threads; i++) spawn(state);
+	}
+
+	Pool::~Pool() {
+		std::lock_guard lock {state->mtx};
+		state->stopping = true;
+		state->queue.clear();
+		state->cv.notify_all();
+	}
+
+	void Pool::request(const string& mountpoint) {
+		const uint64_t now = time_ms();
+		std::lock_guard lock {state->mtx};
+		auto& m = state->mounts[mountpoint];
+		m.last_request = now;
+		if (m.queued or m.running or now < m.retry) return;
+		m.queued = true;
+		state->queue.push_back(mountpoint);
+		state->cv.notify_one();
+	}
+
+	auto Pool::take(const string& mountpoint) -> std::optional<result> {
+		std::lock_guard lock {state->mtx};
+		const auto it = state->mounts.find(mountpoint);
+		if (it == state->mounts.end()) return std::nullopt;
+		return std::exchange(it->second.done, std::nullopt);
+	}
+
+	void Pool::expire() {
+		const uint64_t now = time_ms();
+		std::lock_guard lock {state->mtx};
+		auto& s = *state;
+		for (auto it = s.mounts.begin(); it != s.mounts.end();) {
+			auto& [mountpoint, m] = *it;
+			if (m.running and not m.late and now > m.started + s.timeout_ms) {
+				m.late = true;
+				m.timeouts++;
+				const uint64_t backoff = std::min(s.backoff_ms << std::min(m.timeouts - 1, 16), s.max_backoff_ms);
+				m.retry = now + backoff;
+				s.stuck++;
+				Logger::warning("Statvfs: call for \"{}\" didn't return within {}ms, retrying in {}s", mountpoint, s.timeout_ms, backoff / 1000);
+				if (s.live - s.stuck < s.threads and s.stuck <= max_stuck) spawn(state);
+			}
+			else if (not m.queued and not m.running and now >= m.retry and now > m.last_request + forget_ms) {
+				it = s.mounts.erase(it);
+				continue;
+			}
+			++it;
+		}
+	}
+
+	auto Pool::queued() const -> size_t {
+		std::lock_guard lock {state->mtx};
+		return state->queue.size();
+	}
+
+	auto Pool::timed_out() const -> size_t {
+		const uint64_t now = time_ms();
+		std::lock_guard lock {state->mtx};
+		return std::ranges::count_if(state->mounts, [now](const auto& entry) { return entry.second.late or now < entry.second.retry; });
+	}
+}
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+//* Disk space of the mountpoints, read with statvfs() on a few long lived worker threads so an unresponsive mount
+//* (e.g. a stale NFS or SMB server) only ties up its own worker and never blocks the collector
+namespace Statvfs {
+
+	struct result {
+		uint64_t total{};
+		//? Free space including and excluding the blocks reserved for root
+		uint64_t free{};
+		uint64_t avail{};
+		//? errno of a failed statvfs() call, 0 on success
+		int error{};
+	};
+
+	//* Result of statvfs() on <mountpoint>
+	auto query(const std::string& mountpoint) -> result;
+
+	struct pool_state;
+
+	//* Fixed size pool of worker threads serving requests from a queue, at most one request per mountpoint is queued or running.
+	//* A call running longer than the timeout marks its mountpoint as timed out: it isn't requested again before a back-off
+	//* that doubles with each consecutive timeout, and a replacement worker is started so the other mountpoints keep updating.
+	//* Workers are detached, a worker stuck in statvfs() never delays quitting.
+	class Pool {
+		std::shared_ptr<pool_state> state;
+
+	public:
+		using query_func = std::function<result(const std::string&)>;
+
+		Pool(size_t threads, uint64_t timeout_ms, uint64_t backoff_ms, uint64_t max_backoff_ms, query_func func = query);
+		~Pool();
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		//* Queue a statvfs() call for <mountpoint> unless one is already queued or running, or the mountpoint is backing off
+		void request(const std::string& mountpoint);
+
+		//* The result of the last finished call for <mountpoint>, returned once
+		auto take(const std::string& mountpoint) -> std::optional<result>;
+
+		//* Check running calls against the timeout and forget mountpoints that weren't requested for a while, called once per collect
+		void expire();
+
+		//* Number of requests waiting for a worker
+		auto queued() const -> size_t;
+
+		//* Number of mountpoints that timed out and are backing off or still waiting for their call to return
+		auto timed_out() const -> size_t;
+	};
+}
@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_stream.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <iterator>
+#include <type_traits>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "btop_config.hpp"
+#include "btop_log.hpp"
+#include "btop_tools.hpp"
+
+using Tools::time_ms;
+
+namespace Stream {
+
+	namespace {
+		std::atomic<bool> stop_requested;
+
+		//? Collectors trim their graph data to a multiple of the box width, nothing is drawn so a few samples are enough
+		constexpr int history_width = 8;
+
+		void stop_handler(int) {
+			stop_requested = true;
+		}
+
+		//? Write all of <data> to stdout, returns false if stdout was closed
+		bool write_all(std::string_view data) {
+			while (not data.empty()) {
+				const auto written = ::write(STDOUT_FILENO, data.data(), data.size());
+				if (written < 0) {
+					if (errno == EINTR and not stop_requested) continue;
+					return false;
+				}
+				data.remove_prefix(written);
+			}
+			return true;
+		}
+	}
+
+	Writer::Writer(Format format) : format(format) {
+		buf.reserve(4096);
+	}
+
+	void Writer::key(std::string_view name) {
+		if (not first) buf += ',';
+		first = false;
+		if (format == Format::json and not name.empty()) {
+			buf += '"';
+			buf += name;
+			buf += "\":";
+		}
+	}
+
+	void Writer::text(std::string_view name, std::string_view value) {
+		key(name);
+		if (format == Format::json) {
+			buf += '"';
+			for (const char c : value) {
+				if (c == '"' or c == '\\') {
+					buf += '\\';
+					buf += c;
+				}
+				else if (static_cast<unsigned char>(c) < 0x20) fmt::format_to(std::back_inserter(buf), "\\u{:04x}", c);
+				else buf += c;
+			}
+			buf += '"';
+		}
+		//? CSV fields are quoted when they contain a separator, quote or line break, quotes are doubled
+		else if (value.find_first_of(",\"\r\n") != std::string_view::npos) {
+			buf += '"';
+			for (const char c : value) {
+				if (c == '"') buf += '"';
+				buf += c;
+			}
+			buf += '"';
+		}
+		else buf += value;
+	}
+
+	template <typename T>
+	void Writer::number(std::string_view name, T value) {
+		key(name);
+		if constexpr (std::is_floating_point_v<T>)
+			fmt::format_to(std::back_inserter(buf), "{:.1f}", value);
+		else
+			fmt::format_to(std::back_inserter(buf), "{}", value);
+	}
+
+	void Writer::open(std::string_view name, char bracket) {
+		if (format != Format::json) return;
+		key(name);
+		buf += bracket;
+		first = true;
+	}
+
+	void Writer::close(char bracket) {
+		if (format != Format::json) return;
+		buf += bracket;
+		first = false;
+	}
+
+	auto Writer::header(size_t gpus, size_t procs) -> const std::string& {
+		buf.clear();
+		if (format != Format::csv) return buf;
+		buf += "time,cpu,load_1m,load_5m,load_15m,cpu_temp,"
+			"mem_total,mem_used,mem_available,mem_cached,mem_free,swap_total,swap_used,"
+			"net_iface,net_download,net_upload,net_download_total,net_upload_total";
+		for (size_t i = 0; i < gpus; i++)
+			fmt::format_to(std::back_inserter(buf), ",gpu{0}_util,gpu{0}_mem_used,gpu{0}_mem_total,gpu{0}_temp,gpu{0}_power", i);
+		for (size_t i = 0; i < procs; i++)
+			fmt::format_to(std::back_inserter(buf), ",proc{0}_pid,proc{0}_name,proc{0}_user,proc{0}_cpu,proc{0}_mem", i);
+		buf += '\n';
+		return buf;
+	}
+
+	void Writer::begin(uint64_t time_ms) {
+		buf.clear();
+		first = true;
+		open("", '{');
+		number("time", time_ms);
+	}
+
+	void Writer::cpu(const Cpu::cpu_info& cpu) {
+		open("cpu", '{');
+		const auto& total = cpu.cpu_percent.at("total");
+		number("total", total.empty() ? 0 : total.back());
+		if (format == Format::json) {
+			open("cores", '[');
+			for (const auto& core : cpu.core_percent) number("", core.empty() ? 0 : core.back());
+			close(']');
+		}
+		number("load_1m", cpu.load_avg[0]);
+		number("load_5m", cpu.load_avg[1]);
+		number("load_15m", cpu.load_avg[2]);
+		//? Empty CSV field and null in JSON when there is no temperature sensor
+		if (not cpu.temp.empty() and not cpu.temp[0].empty()) number("temp", cpu.temp[0].back());
+		else {
+			key("temp");
+			if (format == Format::json) buf += "null";
+		}
+		close('}');
+	}
+
+	void Writer::mem(const Mem::mem_info& mem, uint64_t total, double seconds) {
+		open("mem", '{');
+		number("total", total);
+		number("used", mem.stats.at("used"));
+		number("available", mem.stats.at("available"));
+		number("cached", mem.stats.at("cached"));
+		number("free", mem.stats.at("free"));
+		number("swap_total", mem.stats.at("swap_total"));
+		number("swap_used", mem.stats.at("swap_used"));
+		if (format == Format::json) {
+			//? Extended fields are only in JSON so the CSV columns stay the same on every system
+			for (size_t i = 0; i < mem.extended.size(); i++) {
+				if (mem.extended_valid & (1u << i)) number(Mem::extended_names[i], mem.extended[i]);
+			}
+			open("disks", '[');
+			for (const auto& mountpoint : mem.disks_order) {
+				const auto it = mem.disks.find(mountpoint);
+				if (it == mem.disks.end()) continue;
+				const auto& disk = it->second;
+				open("", '{');
+				text("name", disk.name);
+				text("mount", mountpoint);
+				number("total", disk.total);
+				number("used", disk.used);
+				number("free", disk.free);
+				number("read", disk.io_read.empty() ? 0 : static_cast<int64_t>(disk.io_read.back() / seconds));
+				number("write", disk.io_write.empty() ? 0 : static_cast<int64_t>(disk.io_write.back() / seconds));
+				number("read_ops", disk.read_ops);
+				number("write_ops", disk.write_ops);
+				number("queue_ms", disk.queue_ms);
+				close('}');
+			}
+			close(']');
+		}
+		close('}');
+	}
+
+	void Writer::net(std::string_view iface, const Net::net_info& net) {
+		open("net", '{');
+		text("iface", iface);
+		number("download", net.stat.at("download").speed);
+		number("upload", net.stat.at("upload").speed);
+		number("download_total", net.stat.at("download").total);
+		number("upload_total", net.stat.at("upload").total);
+		close('}');
+	}
+
+#ifdef GPU_SUPPORT
+	void Writer::gpus(const std::vector<Gpu::gpu_info>& gpus) {
+		open("gpus", '[');
+		for (size_t i = 0; i < gpus.size(); i++) {
+			const auto& gpu = gpus[i];
+			const auto& util = gpu.gpu_percent.at("gpu-totals");
+			open("", '{');
+			if (format == Format::json) text("name", i < Gpu::gpu_names.size() ? Gpu::gpu_names[i] : "");
+			number("util", util.empty() ? 0 : util.back());
+			number("mem_used", gpu.mem_used);
+			number("mem_total", gpu.mem_total);
+			number("temp", gpu.temp.empty() ? 0 : gpu.temp.back());
+			number("power", gpu.pwr_usage);
+			close('}');
+		}
+		close(']');
+	}
+#endif
+
+	void Writer::procs(const std::vector<Proc::proc_info>& procs, size_t count) {
+		open("procs", '[');
+		size_t written = 0;
+		for (const auto& p : procs) {
+			if (written == count) break;
+			if (p.filtered) continue;
+			open("", '{');
+			number("pid", p.pid);
+			text("name", p.name);
+			if (format == Format::json) text("cmd", p.cmd);
+			text("user", p.user);
+			number("cpu", p.cpu_p);
+			number("mem", p.mem);
+			if (format == Format::json) number("threads", p.threads);
+			close('}');
+			written++;
+		}
+		close(']');
+		for (; format == Format::csv and written < count; written++) {
+			for (int i = 0; i < 5; i++) key("");
+		}
+	}
+
+	auto Writer::end() -> const std::string& {
+		close('}');
+		buf += '\n';
+		return buf;
+	}
+
+	int run(Format format, uint64_t interval_ms, size_t procs) {
+		std::signal(SIGINT, stop_handler);
+		std::signal(SIGTERM, stop_handler);
+		std::signal(SIGHUP, stop_handler);
+		std::signal(SIGPIPE, SIG_IGN);
+
+		Cpu::width = Mem::width = Net::width = history_width;
+	#ifdef GPU_SUPPORT
+		Gpu::width = history_width;
+	#endif
+		//? Only the command lines of the processes that are written need to be read with proc_lazy_cmdline
+		Proc::select_max = procs;
+		Config::set("proc_tree", false);
+
+		try {
+			Shared::init();
+		}
+		catch (const std::exception& e) {
+			Logger::error("Exception in Shared::init() -> {}", e.what());
+			fmt::println(stderr, "ERROR: Exception in Shared::init() -> {}", e.what());
+			return 1;
+		}
+		const uint64_t total_mem = Mem::get_totalMem();
+
+		Writer writer(format);
+	#ifdef GPU_SUPPORT
+		bool open = write_all(writer.header(Gpu::gpu_names.size(), procs));
+	#else
+		bool open = write_all(writer.header(0, procs));
+	#endif
+
+		//? Usage is measured between two collections, the first sample is taken one interval after the initial collection.
+		//? Shared::init() already collected cpu and mem.
+		try {
+			Net::collect();
+			Proc::collect();
+		}
+		catch (const std::exception& e) {
+			Logger::error("Exception while streaming -> {}", e.what());
+			fmt::println(stderr, "ERROR: Exception while streaming -> {}", e.what());
+			return 1;
+		}
+		uint64_t last_time = time_ms(), next_time = last_time + interval_ms;
+
+		while (open and not stop_requested) {
+			//? Samples are taken at fixed times, a sample that ran late moves the schedule instead of causing a burst of samples
+			for (uint64_t current; not stop_requested and (current = time_ms()) < next_time;) {
+				poll(nullptr, 0, static_cast<int>(next_time - current));
+			}
+			if (stop_requested) break;
+
+			const uint64_t now = time_ms();
+			const double seconds = std::max<uint64_t>(now - last_time, 1) / 1000.0;
+			last_time = now;
+			next_time += interval_ms;
+			if (next_time <= now) next_time = now + interval_ms;
+
+			try {
+				writer.begin(now);
+				writer.cpu(Cpu::collect());
+				writer.mem(Mem::collect(), total_mem, seconds);
+				//? Net::collect() may select a new interface, so it has to run before selected_iface is read
+				auto& net = Net::collect();
+				writer.net(Net::selected_iface, net);
+			#ifdef GPU_SUPPORT
+				if (not Gpu::gpu_names.empty()) writer.gpus(Gpu::collect());
+			#endif
+				writer.procs(Proc::collect(), procs);
+			}
+			catch (const std::exception& e) {
+				Logger::error("Exception while streaming -> {}", e.what());
+				fmt::println(stderr, "ERROR: Exception while streaming -> {}", e.what());
+				return 1;
+			}
+			open = write_all(writer.end());
+		}
+
+	#ifdef GPU_SUPPORT
+		Gpu::Nvml::shutdown();
+		Gpu::Rsmi::shutdown();
+		Gpu::Asysfs::shutdown();
+		#ifdef __APPLE__
+		Gpu::AppleSilicon::shutdown();
+		#endif
+	#endif
+		return 0;
+	}
+}
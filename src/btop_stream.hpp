@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "btop_shared.hpp"
+
+//* Headless mode started with --stream, writes the collected data to stdout as JSON lines or CSV without a terminal
+namespace Stream {
+
+	enum class Format { json, csv };
+
+	//* Serializes samples into a buffer that is reused between samples, nothing is allocated once the buffer has grown to the size of a sample.
+	//* JSON samples are written as one object per line and CSV samples as one row per line with the columns from header().
+	//* Per core loads and disks are only included in JSON samples.
+	class Writer {
+		Format format;
+		std::string buf;
+		//? Set at the start of an object, array or row when the next value doesn't need a separator
+		bool first = true;
+
+		void key(std::string_view name);
+		void text(std::string_view name, std::string_view value);
+		template <typename T>
+		void number(std::string_view name, T value);
+		void open(std::string_view name, char bracket);
+		void close(char bracket);
+
+	public:
+		explicit Writer(Format format);
+
+		//* CSV header row for <gpus> gpus and <procs> processes, empty for JSON
+		auto header(size_t gpus, size_t procs) -> const std::string&;
+
+		//* Start a new sample taken at <time_ms> since epoch
+		void begin(uint64_t time_ms);
+
+		void cpu(const Cpu::cpu_info& cpu);
+
+		//* <total> is the total memory in bytes, disk io is reported per second using the <seconds> passed since the last sample
+		void mem(const Mem::mem_info& mem, uint64_t total, double seconds);
+
+		void net(std::string_view iface, const Net::net_info& net);
+
+	#ifdef GPU_SUPPORT
+		void gpus(const std::vector<Gpu::gpu_info>& gpus);
+	#endif
+
+		//* The first <count> processes of <procs> that aren't filtered, in the order they were sorted in.
+		//* CSV rows always get <count> process columns, left empty when there are fewer processes.
+		void procs(const std::vector<Proc::proc_info>& procs, size_t count);
+
+		//* Finish the sample and return the line to write, the string is reused for the next sample
+		auto end() -> const std::string&;
+	};
+
+	//* Initialize the collectors and write a sample with the top <procs> processes to stdout every <interval_ms> milliseconds,
+	//* until interrupted or stdout is closed. Returns the exit code.
+	int run(Format format, uint64_t interval_ms, size_t procs);
+}
@@ -18,6 +18,7 @@ tab-size = 4
 
 #include <cmath>
 #include <ctime>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -621,6 +622,92 @@ namespace Tools {
 		atom.wait_for(old, wait_ms);
 	}
 
+	ThreadPool::ThreadPool(size_t threads) {
+		resize(threads);
+	}
+
+	ThreadPool::~ThreadPool() {
+		stop_workers();
+	}
+
+	void ThreadPool::worker_loop() {
+		for (;;) {
+			std::function<void()> job;
+			{
+				std::unique_lock lock {mtx};
+				cv.wait(lock, [this] { return stopping or not jobs.empty(); });
+				if (jobs.empty()) return;
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	void ThreadPool::stop_workers() {
+		{
+			std::lock_guard lock {mtx};
+			stopping = true;
+		}
+		cv.notify_all();
+		for (auto& worker : workers) worker.join();
+		workers.clear();
+		stopping = false;
+	}
+
+	void ThreadPool::resize(size_t threads) {
+		stop_workers();
+		workers.reserve(threads);
+		for (size_t i = 0; i < threads; i++) workers.emplace_back(&ThreadPool::worker_loop, this);
+	}
+
+	size_t ThreadPool::size() const noexcept {
+		return workers.size();
+	}
+
+	void ThreadPool::submit(std::function<void()> job) {
+		{
+			std::lock_guard lock {mtx};
+			jobs.push_back(std::move(job));
+		}
+		cv.notify_one();
+	}
+
+	void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& func, size_t threads) {
+		size_t helpers = std::min(workers.size(), count > 0 ? count - 1 : 0);
+		if (threads > 0) helpers = std::min(helpers, threads - 1);
+		atomic<size_t> next_index{};
+		size_t running = helpers;
+		std::mutex done_mtx;
+		std::condition_variable done_cv;
+		std::exception_ptr error;
+
+		auto run = [&] {
+			try {
+				for (size_t i; (i = next_index.fetch_add(1, std::memory_order_relaxed)) < count;) func(i);
+			}
+			catch (...) {
+				next_index = count;
+				std::lock_guard lock {done_mtx};
+				if (not error) error = std::current_exception();
+			}
+		};
+
+		for (size_t i = 0; i < helpers; i++) {
+			submit([&] {
+				run();
+				std::lock_guard lock {done_mtx};
+				if (--running == 0) done_cv.notify_one();
+			});
+		}
+		run();
+
+		//? Helpers reference this stack frame, so wait for all of them even if all indexes are done
+		std::unique_lock lock {done_mtx};
+		done_cv.wait(lock, [&] { return running == 0; });
+		if (error) std::rethrow_exception(error);
+	}
+
 	string readfile(const std::filesystem::path& path, const string& fallback) {
 		if (not fs::exists(path)) return fallback;
 		string out;
@@ -29,7 +29,9 @@ tab-size = 4
 #include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <limits.h>
 #include <mutex>
 #include <ranges>
@@ -422,6 +424,38 @@ namespace Tools {
 
 	void atomic_wait_for(const atomic_waiting_lock& atom, bool old = true, const uint64_t wait_ms = 0);
 
+	//* Pool of worker threads running queued jobs, workers inherit the signal mask of the thread that starts them
+	class ThreadPool {
+		vector<std::thread> workers;
+		std::deque<std::function<void()>> jobs;
+		std::mutex mtx;
+		std::condition_variable cv;
+		bool stopping{};
+
+		void worker_loop();
+		void stop_workers();
+	public:
+		ThreadPool() = default;
+		explicit ThreadPool(size_t threads);
+		~ThreadPool();
+		ThreadPool(const ThreadPool& other) = delete;
+		ThreadPool& operator=(const ThreadPool& other) = delete;
+		ThreadPool(ThreadPool&& other) = delete;
+		ThreadPool& operator=(ThreadPool&& other) = delete;
+
+		//* Finish queued jobs, join all workers and start <threads> new workers
+		void resize(size_t threads);
+		size_t size() const noexcept;
+
+		//* Queue <job> to run on the next free worker
+		void submit(std::function<void()> job);
+
+		//* Call <func> for every index in [0, <count>) using the workers and the calling thread, returns when all calls are done.
+		//* The first exception thrown by <func> is rethrown in the calling thread.
+		//* A non zero <threads> limits the number of threads used, counting the calling thread.
+		void parallel_for(size_t count, const std::function<void(size_t)>& func, size_t threads = 0);
+	};
+
 	//* Read a complete file and return as a string
 	string readfile(const std::filesystem::path& path, const string& fallback = "");
 
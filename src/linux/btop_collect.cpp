@@ -22,22 +22,22 @@ tab-size = 4
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
-#include <future>
 #include <iterator>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include <arpa/inet.h> // for inet_ntop()
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netdb.h>
-#include <sys/statvfs.h>
 #include <unistd.h>
 
 #include <fmt/format.h>
@@ -54,7 +54,10 @@ tab-size = 4
 #include "../btop_config.hpp"
 #include "../btop_log.hpp"
 #include "../btop_shared.hpp"
+#include "../btop_statvfs.hpp"
 #include "../btop_tools.hpp"
+#include "proc_events.hpp"
+#include "procfs.hpp"
 
 #if defined(GPU_SUPPORT)
 	// Redefining C++ keywords fortunately has a warning in clang, however it's unavoidable here
@@ -87,8 +90,6 @@ using std::numeric_limits;
 using std::round;
 using std::streamsize;
 using std::vector;
-using std::future;
-using std::async;
 using std::pair;
 
 
@@ -328,6 +329,7 @@ namespace Mem {
 namespace Shared {
 
 	fs::path procPath, passwd_path;
+	int procFd = -1;
 	long pageSize, clkTck, coreCount;
 
 	void init() {
@@ -337,6 +339,10 @@ namespace Shared {
 		if (procPath.empty())
 			throw std::runtime_error("Proc filesystem not found or no permission to read from it!");
 
+		procFd = open(procPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (procFd < 0)
+			throw std::runtime_error("Failed to open proc filesystem!");
+
 		passwd_path = (fs::is_regular_file(fs::path("/etc/passwd")) and access("/etc/passwd", R_OK) != -1) ? "/etc/passwd" : "";
 		if (passwd_path.empty())
 			Logger::warning("Could not read /etc/passwd, will show UID instead of username.");
@@ -441,21 +447,31 @@ namespace Cpu {
 		"user"s, "nice"s, "system"s, "idle"s, "iowait"s,
 		"irq"s, "softirq"s, "steal"s, "guest"s, "guest_nice"s
 	};
+	static_assert(time_names.size() == Procfs::cpu_stat::field_count);
 
-	std::unordered_map<string, long long> cpu_old = {
-			{"totals", 0},
-			{"idles", 0},
-			{"user", 0},
-			{"nice", 0},
-			{"system", 0},
-			{"idle", 0},
-			{"iowait", 0},
-			{"irq", 0},
-			{"softirq", 0},
-			{"steal", 0},
-			{"guest", 0},
-			{"guest_nice", 0}
-	};
+	long long cpu_old_totals{};
+	long long cpu_old_idles{};
+	array<long long, Procfs::cpu_stat::field_count> cpu_old_times{};
+
+	//? Pointers into cpu_info::cpu_percent in the order of time_names, resolved on first collect to avoid string lookups every update
+	RingBuffer<uint8_t>* total_percent{};
+	array<RingBuffer<uint8_t>*, Procfs::cpu_stat::field_count> time_percent{};
+
+	//? Buffer for /proc/stat, grown until all "cpu" lines fit in a single read
+	vector<char> stat_buffer(64 << 10);
+
+	auto read_stat() -> std::optional<std::string_view> {
+		while (true) {
+			auto stat = Procfs::read_at(Shared::procFd, "stat", stat_buffer);
+			if (not stat.has_value() or stat->size() < stat_buffer.size()) return stat;
+
+			//? A full buffer is fine as long as a line after the "cpu" lines was reached
+			for (size_t pos = stat->find('\n'); pos != std::string_view::npos; pos = stat->find('\n', pos + 1)) {
+				if (pos + 1 < stat->size() and stat->at(pos + 1) != 'c') return stat;
+			}
+			stat_buffer.resize(stat_buffer.size() * 2);
+		}
+	}
 
 	string get_cpuName() {
 		string name;
@@ -1112,110 +1128,86 @@ namespace Cpu {
 			Logger::error("failed to get load averages");
 		}
 
-		ifstream cread;
-
 		try {
 			//? Get cpu total times for all cores from /proc/stat
-			string cpu_name;
-			cread.open(Shared::procPath / "stat");
-			int i = 0;
-			int target = Shared::coreCount;
-			for (; i <= target or (cread.good() and cread.peek() == 'c'); i++) {
-				//? Make sure to add zero value for missing core values if at end of file
-				if ((not cread.good() or cread.peek() != 'c') and i <= target) {
-					if (i == 0) throw std::runtime_error("Failed to parse /proc/stat");
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						cpu.core_percent.at(i-1).push_back(0);
-					}
-				}
-				else {
-					if (i == 0) cread.ignore(SSmax, ' ');
-					else {
-						cread >> cpu_name;
-						int cpuNum = std::stoi(cpu_name.substr(3));
-						if (cpuNum >= target - 1) target = cpuNum + (cread.peek() == 'c' ? 2 : 1);
-
-						//? Add zero value for core if core number is missing from /proc/stat
-						while (i - 1 < cpuNum) {
-							//? Fix container sizes if new cores are detected
-							while (cmp_less(cpu.core_percent.size(), i)) {
-								core_old_totals.push_back(0);
-								core_old_idles.push_back(0);
-								cpu.core_percent.emplace_back();
-							}
-							cpu.core_percent[i-1].push_back(0);
-							if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
-							i++;
-						}
-					}
+			const auto stat = read_stat();
+			if (not stat.has_value()) throw std::runtime_error("Failed to read /proc/stat");
+			Procfs::Scanner scan { *stat };
 
-					//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
-					vector<long long> times;
-					long long total_sum = 0;
+			//? Calculate values for totals from first line of stat
+			const auto all = Procfs::parse_cpu_stat(scan);
+			if (not all.has_value() or all->core != -1) throw std::runtime_error("Failed to parse /proc/stat");
+			{
+				const long long totals = all->total();
+				const long long idles = all->idle_total();
+				const long long calc_totals = max(1ll, totals - cpu_old_totals);
+				const long long calc_idles = max(0ll, idles - cpu_old_idles);
+				cpu_old_totals = totals;
+				cpu_old_idles = idles;
 
-					for (uint64_t val; cread >> val; total_sum += val) {
-						times.push_back(val);
-					}
-					cread.clear();
-					if (times.size() < 4) throw std::runtime_error("Malformed /proc/stat");
+				if (time_percent.front() == nullptr) {
+					total_percent = &cpu.cpu_percent.at("total");
+					for (size_t ii = 0; ii < time_names.size(); ii++) time_percent[ii] = &cpu.cpu_percent.at(time_names[ii]);
+				}
 
-					//? Subtract fields 8-9 and any future unknown fields
-					const long long totals = max(0ll, total_sum - (times.size() > 8 ? std::accumulate(times.begin() + 8, times.end(), 0ll) : 0));
+				//? Total usage of cpu
+				total_percent->push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
 
-					//? Add iowait field if present
-					const long long idles = max(0ll, times.at(3) + (times.size() > 4 ? times.at(4) : 0));
+				//? Reduce size if there are more values than needed for graph
+				while (cmp_greater(total_percent->size(), width * 2)) total_percent->pop_front();
 
-					//? Calculate values for totals from first line of stat
-					if (i == 0) {
-						const long long calc_totals = max(1ll, totals - cpu_old.at("totals"));
-						const long long calc_idles = max(0ll, idles - cpu_old.at("idles"));
-						cpu_old.at("totals") = totals;
-						cpu_old.at("idles") = idles;
+				//? Populate cpu.cpu_percent with all fields from stat
+				for (size_t ii = 0; ii < all->count; ii++) {
+					const long long val = all->times[ii];
+					time_percent[ii]->push_back(clamp((long long)round((double)(val - cpu_old_times[ii]) * 100 / calc_totals), 0ll, 100ll));
+					cpu_old_times[ii] = val;
 
-						//? Total usage of cpu
-						cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+					//? Reduce size if there are more values than needed for graph
+					while (cmp_greater(time_percent[ii]->size(), width * 2)) time_percent[ii]->pop_front();
+				}
+			}
 
-						//? Reduce size if there are more values than needed for graph
-						while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
+			//? Fix container sizes if new cores are detected
+			auto fit_core = [&](int core) {
+				while (not cmp_greater(cpu.core_percent.size(), core)) {
+					core_old_totals.push_back(0);
+					core_old_idles.push_back(0);
+					cpu.core_percent.emplace_back();
+				}
+			};
+			auto push_core = [&](int core, long long value) {
+				fit_core(core);
+				auto& core_percent = cpu.core_percent[core];
+				core_percent.push_back(value);
 
-						//? Populate cpu.cpu_percent with all fields from stat
-						for (int ii = 0; const auto& val : times) {
-							cpu.cpu_percent.at(time_names.at(ii)).push_back(clamp((long long)round((double)(val - cpu_old.at(time_names.at(ii))) * 100 / calc_totals), 0ll, 100ll));
-							cpu_old.at(time_names.at(ii)) = val;
+				//? Reduce size if there are more values than needed for graph
+				if (core_percent.size() > 40) core_percent.pop_front();
+			};
 
-							//? Reduce size if there are more values than needed for graph
-							while (cmp_greater(cpu.cpu_percent.at(time_names.at(ii)).size(), width * 2)) cpu.cpu_percent.at(time_names.at(ii)).pop_front();
+			//? Calculate cpu total for each core
+			int next_core = 0;
+			for (auto line = Procfs::parse_cpu_stat(scan); line.has_value(); line = Procfs::parse_cpu_stat(scan)) {
+				const int core = line->core;
+				if (core < 0) throw std::runtime_error("Malformed /proc/stat");
 
-							if (++ii == 10) break;
-						}
-						continue;
-					}
-					//? Calculate cpu total for each core
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						const long long calc_totals = max(1ll, totals - core_old_totals.at(i-1));
-						const long long calc_idles = max(0ll, idles - core_old_idles.at(i-1));
-						core_old_totals.at(i-1) = totals;
-						core_old_idles.at(i-1) = idles;
+				//? Add zero value for core if core number is missing from /proc/stat
+				for (; next_core < core; next_core++) push_core(next_core, 0);
 
-						cpu.core_percent.at(i-1).push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
-					}
-				}
+				fit_core(core);
+				const long long totals = line->total();
+				const long long idles = line->idle_total();
+				const long long calc_totals = max(1ll, totals - core_old_totals[core]);
+				const long long calc_idles = max(0ll, idles - core_old_idles[core]);
+				core_old_totals[core] = totals;
+				core_old_idles[core] = idles;
 
-				//? Reduce size if there are more values than needed for graph
-				if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
+				push_core(core, clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+				next_core = max(next_core, core + 1);
 			}
+			if (scan.rest().starts_with("cpu")) throw std::runtime_error("Malformed /proc/stat");
+
+			//? Make sure to add zero value for missing core values if at end of file
+			for (; next_core < Shared::coreCount; next_core++) push_core(next_core, 0);
 
 			//? Notify main thread to redraw screen if we found more cores than previously detected
 			if (cmp_greater(cpu.core_percent.size(), Shared::coreCount)) {
@@ -1228,8 +1220,7 @@ namespace Cpu {
 		}
 		catch (const std::exception& e) {
 			Logger::debug("Cpu::collect() : {}", e.what());
-			if (cread.bad()) throw std::runtime_error("Failed to read /proc/stat");
-			else throw std::runtime_error(fmt::format("Cpu::collect() : {}", e.what()));
+			throw std::runtime_error(fmt::format("Cpu::collect() : {}", e.what()));
 		}
 
 		if (Config::getB("check_temp") and got_sensors)
@@ -2271,36 +2262,6 @@ namespace Gpu {
 }
 #endif
 
-/// Convert ascii escapes like \040 into chars.
-static auto convert_ascii_escapes(const std::string& input) -> std::string {
-    std::string out;
-    out.reserve(input.size());
-
-    for (std::size_t i = 0; i < input.size(); ++i) {
-        if (input[i] == '\\' &&
-	    	// Peek the next three characters.
-            i + 3 < input.size() &&
-            std::isdigit(input[i + 1]) &&
-            std::isdigit(input[i + 2]) &&
-            std::isdigit(input[i + 3])) {
-
-			// Convert octal chars to decimal int.
-			//   '0' - '0' -> 0, '4' - '0' -> 4, '0' - '0' -> 0.
-			//   0 * 64 (0)
-			//   + 4 * 8 (32)
-			//   + 0
-			//   = 32 (ascii space)
-            int value = ((input[i + 1] - '0') * 64) + ((input[i + 2] - '0') * 8) + (input[i + 3] - '0');
-            out.push_back(static_cast<char>(value));
-            // Consume the three digits.
-            i += 3;
-        } else {
-            out.push_back(input[i]);
-        }
-    }
-    return out;
-}
-
 namespace Mem {
 	bool has_swap{};
 	vector<string> fstab;
@@ -2316,113 +2277,133 @@ namespace Mem {
 
 	mem_info current_mem {};
 
+	//? Buffer for /proc/meminfo, grown until the whole file fits in a single read
+	vector<char> meminfo_buffer(8 << 10);
+
+	auto read_meminfo() -> std::optional<std::string_view> {
+		while (true) {
+			auto meminfo = Procfs::read_at(Shared::procFd, "meminfo", meminfo_buffer);
+			if (not meminfo.has_value() or meminfo->size() < meminfo_buffer.size()) return meminfo;
+			meminfo_buffer.resize(meminfo_buffer.size() * 2);
+		}
+	}
+
 	uint64_t get_totalMem() {
-		ifstream meminfo(Shared::procPath / "meminfo");
-		int64_t totalMem = 0;
-		if (meminfo.good()) {
-			meminfo.ignore(SSmax, ':');
-			meminfo >> totalMem;
-			totalMem <<= 10;
-		}
-		if (not meminfo.good() or totalMem == 0)
+		//? MemTotal is the first line, so a small buffer on the stack is enough and this is safe to call from any thread
+		std::array<char, 128> buffer;
+		const auto meminfo = Procfs::read_at(Shared::procFd, "meminfo", buffer);
+		const auto totalMem = meminfo.has_value() ? Procfs::parse_meminfo(*meminfo)[Procfs::meminfo_stat::mem_total] : 0;
+		if (totalMem == 0)
 			throw std::runtime_error("Could not get total memory size from /proc/meminfo");
 
 		return totalMem;
 	}
 
+	//? Each stat paired with its percent history in the order of <names>, resolved once so updates do no string lookups
+	template <size_t N>
+	auto resolve_fields(const array<string, N>& names) {
+		array<std::pair<const uint64_t*, RingBuffer<uint8_t>*>, N> out;
+		for (size_t i = 0; i < N; i++) out[i] = { &current_mem.stats.at(names[i]), &current_mem.percent.at(names[i]) };
+		return out;
+	}
+	const auto mem_fields = resolve_fields(mem_names);
+	const auto swap_fields = resolve_fields(swap_names);
+
 	auto collect(bool no_update) -> mem_info& {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty())) return current_mem;
+		//? mem_fields starts with "used"
+		if (Runner::stopping or (no_update and not mem_fields[0].second->empty())) return current_mem;
 		auto show_swap = Config::getB("show_swap");
 		auto swap_disk = Config::getB("swap_disk");
 		auto show_disks = Config::getB("show_disks");
 		auto zfs_arc_cached = Config::getB("zfs_arc_cached");
-		auto totalMem = get_totalMem();
 		auto& mem = current_mem;
+		uint64_t totalMem = 0;
 
-		mem.stats.at("swap_total") = 0;
-
-		//? Read ZFS ARC info from /proc/spl/kstat/zfs/arcstats
-		uint64_t arc_size = 0, arc_min_size = 0;
-		if (zfs_arc_cached) {
-			ifstream arcstats(Shared::procPath / "spl/kstat/zfs/arcstats");
-			if (arcstats.good()) {
-				for (string label; arcstats >> label;) {
-					if (label == "c_min") {
-						arcstats >> arc_min_size >> arc_min_size; // double read skips type column
-					}
-					else if (label == "size") {
-						arcstats >> arc_size >> arc_size;
-						break;
+		if (collect_mem) {
+			//? Read ZFS ARC info from /proc/spl/kstat/zfs/arcstats
+			uint64_t arc_size = 0, arc_min_size = 0;
+			if (zfs_arc_cached) {
+				ifstream arcstats(Shared::procPath / "spl/kstat/zfs/arcstats");
+				if (arcstats.good()) {
+					for (string label; arcstats >> label;) {
+						if (label == "c_min") {
+							arcstats >> arc_min_size >> arc_min_size; // double read skips type column
+						}
+						else if (label == "size") {
+							arcstats >> arc_size >> arc_size;
+							break;
+						}
 					}
 				}
+				arcstats.close();
 			}
-			arcstats.close();
-		}
 
-		//? Read memory info from /proc/meminfo
-		ifstream meminfo(Shared::procPath / "meminfo");
-		if (meminfo.good()) {
-			bool got_avail = false;
-			for (string label; meminfo.peek() != 'D' and meminfo >> label;) {
-				if (label == "MemFree:") {
-					meminfo >> mem.stats.at("free");
-					mem.stats.at("free") <<= 10;
-				}
-				else if (label == "MemAvailable:") {
-					meminfo >> mem.stats.at("available");
-					mem.stats.at("available") <<= 10;
-					got_avail = true;
-				}
-				else if (label == "Cached:") {
-					meminfo >> mem.stats.at("cached");
-					mem.stats.at("cached") <<= 10;
-					if (not show_swap and not swap_disk) break;
-				}
-				else if (label == "SwapTotal:") {
-					meminfo >> mem.stats.at("swap_total");
-					mem.stats.at("swap_total") <<= 10;
-				}
-				else if (label == "SwapFree:") {
-					meminfo >> mem.stats.at("swap_free");
-					mem.stats.at("swap_free") <<= 10;
-					break;
-				}
-				meminfo.ignore(SSmax, '\n');
-			}
-			if (not got_avail) mem.stats.at("available") = mem.stats.at("free") + mem.stats.at("cached");
+			//? Read memory info from /proc/meminfo
+			const auto meminfo = read_meminfo();
+			if (not meminfo.has_value())
+				throw std::runtime_error("Failed to read /proc/meminfo");
+			using MemInfo = Procfs::meminfo_stat;
+			const auto info = Procfs::parse_meminfo(*meminfo);
+			totalMem = info[MemInfo::mem_total];
+			if (totalMem == 0)
+				throw std::runtime_error("Could not get total memory size from /proc/meminfo");
+
+			//? References into mem.stats, resolved once so updates do no string lookups
+			static auto& stat_used = mem.stats.at("used");
+			static auto& stat_available = mem.stats.at("available");
+			static auto& stat_cached = mem.stats.at("cached");
+			static auto& stat_free = mem.stats.at("free");
+			static auto& stat_swap_total = mem.stats.at("swap_total");
+			static auto& stat_swap_used = mem.stats.at("swap_used");
+			static auto& stat_swap_free = mem.stats.at("swap_free");
+
+			stat_free = info[MemInfo::mem_free];
+			stat_cached = info[MemInfo::cached];
+			stat_available = info.has(MemInfo::mem_available) ? info[MemInfo::mem_available] : stat_free + stat_cached;
 			if (zfs_arc_cached) {
-				mem.stats.at("cached") += arc_size;
+				stat_cached += arc_size;
 				// The ARC will not shrink below arc_min_size, so that memory is not available
 				if (arc_size > arc_min_size)
-					mem.stats.at("available") += arc_size - arc_min_size;
+					stat_available += arc_size - arc_min_size;
 			}
-			mem.stats.at("used") = totalMem - (mem.stats.at("available") <= totalMem ? mem.stats.at("available") : mem.stats.at("free"));
+			stat_used = totalMem - (stat_available <= totalMem ? stat_available : stat_free);
 
-			if (mem.stats.at("swap_total") > 0) mem.stats.at("swap_used") = mem.stats.at("swap_total") - mem.stats.at("swap_free");
-		}
-		else
-			throw std::runtime_error("Failed to read /proc/meminfo");
+			stat_swap_total = info[MemInfo::swap_total];
+			stat_swap_free = info[MemInfo::swap_free];
+			if (stat_swap_total > 0) stat_swap_used = stat_swap_total - stat_swap_free;
 
-		meminfo.close();
+			mem.extended_valid = 0;
+			const auto extend = [&](extended_field field, bool valid, uint64_t value) {
+				mem.extended[field] = valid ? value : 0;
+				if (valid) mem.extended_valid |= 1u << field;
+			};
+			extend(dirty, info.has(MemInfo::dirty), info[MemInfo::dirty]);
+			extend(writeback, info.has(MemInfo::writeback), info[MemInfo::writeback]);
+			extend(shmem, info.has(MemInfo::shmem), info[MemInfo::shmem]);
+			extend(slab, info.has(MemInfo::slab), info[MemInfo::slab]);
+			extend(hugepages, info.has(MemInfo::hugepages_total) and info.has(MemInfo::hugepages_free) and info.has(MemInfo::hugepage_size),
+				(info[MemInfo::hugepages_total] - min(info[MemInfo::hugepages_free], info[MemInfo::hugepages_total])) * info[MemInfo::hugepage_size]);
+			extend(committed, info.has(MemInfo::committed_as), info[MemInfo::committed_as]);
 
-		//? Calculate percentages
-		for (const auto& name : mem_names) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / totalMem));
-			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
-		}
+			//? Calculate percentages
+			for (const auto& [value, percent] : mem_fields) {
+				percent->push_back(round((double)*value * 100 / totalMem));
+				while (cmp_greater(percent->size(), width * 2)) percent->pop_front();
+			}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
-			for (const auto& name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
-				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+			if (show_swap and stat_swap_total > 0) {
+				for (const auto& [value, percent] : swap_fields) {
+					percent->push_back(round((double)*value * 100 / stat_swap_total));
+					while (cmp_greater(percent->size(), width * 2)) percent->pop_front();
+				}
+				has_swap = true;
 			}
-			has_swap = true;
+			else
+				has_swap = false;
 		}
-		else
-			has_swap = false;
 
 		//? Get disks stats
-		if (show_disks) {
+		if (show_disks and collect_disks) {
 			static vector<string> ignore_list;
 			double uptime = system_uptime();
 			auto free_priv = Config::getB("disk_free_priv");
@@ -2433,34 +2414,18 @@ namespace Mem {
 				auto only_physical = Config::getB("only_physical");
 				auto zfs_hide_datasets = Config::getB("zfs_hide_datasets");
 				auto& disks = mem.disks;
-				static std::unordered_map<string, future<pair<disk_info, int>>> disks_stats_promises;
+				//? Unresponsive mounts time out after 2 seconds and are retried after 10 seconds, doubling up to 10 minutes
+				static Statvfs::Pool statvfs_pool {4, 2'000, 10'000, 600'000};
 				ifstream diskread;
 
-				vector<string> filter;
-				if (not disks_filter.empty()) {
-					filter = ssplit(disks_filter);
-					if (filter.at(0).starts_with("exclude=")) {
-						filter_exclude = true;
-						filter.at(0) = filter.at(0).substr(8);
-					}
-				}
-
-				//? Get list of "real" filesystems from /proc/filesystems
-				vector<string> fstypes;
-				if (only_physical and not use_fstab) {
-					fstypes = {"zfs", "wslfs", "drvfs"};
-					diskread.open(Shared::procPath / "filesystems");
-					if (diskread.good()) {
-						for (string fstype; diskread >> fstype;) {
-							if (not is_in(fstype, "nodev", "squashfs", "nullfs"))
-								fstypes.push_back(fstype);
-							diskread.ignore(SSmax, '\n');
-						}
-					}
-					else
-						throw std::runtime_error("Failed to read /proc/filesystems");
-					diskread.close();
-				}
+				//? The mount table is cached and only matched against the options again when it, fstab or the options changed
+				static Procfs::MountTable mount_table;
+				static std::tuple<string, bool, bool, bool, bool, size_t> last_options;
+				if (not mount_table.is_open()
+				and not mount_table.open(Shared::procPath / "self/mounts", true)
+				and not mount_table.open("/etc/mtab", false))
+					throw std::runtime_error("Failed to get mounts from /etc/mtab and /proc/self/mounts");
+				bool rescan = mount_table.update();
 
 				//? Get disk list to use from fstab if enabled
 				if (use_fstab and fs::last_write_time("/etc/fstab") != fstab_time) {
@@ -2484,23 +2449,49 @@ namespace Mem {
 					else
 						throw std::runtime_error("Failed to read /etc/fstab");
 					diskread.close();
+					rescan = true;
 				}
 
-				//? Get mounts from /etc/mtab or /proc/self/mounts
-				diskread.open((fs::exists("/etc/mtab") ? fs::path("/etc/mtab") : Shared::procPath / "self/mounts"));
-				if (diskread.good()) {
+				if (auto options = std::tuple{disks_filter, use_fstab, only_physical, zfs_hide_datasets, swap_disk and has_swap, ignore_list.size()}; options != last_options) {
+					last_options = std::move(options);
+					rescan = true;
+				}
+
+				if (rescan) {
+					vector<string> filter;
+					if (not disks_filter.empty()) {
+						filter = ssplit(disks_filter);
+						if (filter.at(0).starts_with("exclude=")) {
+							filter_exclude = true;
+							filter.at(0) = filter.at(0).substr(8);
+						}
+					}
+
+					//? Get list of "real" filesystems from /proc/filesystems
+					vector<string> fstypes;
+					if (only_physical and not use_fstab) {
+						fstypes = {"zfs", "wslfs", "drvfs"};
+						diskread.open(Shared::procPath / "filesystems");
+						if (diskread.good()) {
+							for (string fstype; diskread >> fstype;) {
+								if (not is_in(fstype, "nodev", "squashfs", "nullfs"))
+									fstypes.push_back(fstype);
+								diskread.ignore(SSmax, '\n');
+							}
+						}
+						else
+							throw std::runtime_error("Failed to read /proc/filesystems");
+						diskread.close();
+					}
+
 					vector<string> found;
 					found.reserve(last_found.size());
-					string dev, mountpoint, fstype;
-					while (not diskread.eof()) {
+					std::unordered_set<string> found_set;
+					found_set.reserve(last_found.size());
+					const std::unordered_set<string> last_set(last_found.begin(), last_found.end());
+					for (const auto& [dev, mountpoint, fstype] : mount_table.mounts()) {
 						std::error_code ec;
-						diskread >> dev >> mountpoint >> fstype;
-						diskread.ignore(SSmax, '\n');
-
-						// A mountpoint can ascii escape codes, which will not work with `statvfs`.
-						mountpoint = convert_ascii_escapes(mountpoint);
-
-						if (v_contains(ignore_list, mountpoint) or v_contains(found, mountpoint)) continue;
+						if (v_contains(ignore_list, mountpoint) or found_set.contains(mountpoint)) continue;
 
 						//? Match filter if not empty
 						if (not filter.empty()) {
@@ -2517,7 +2508,8 @@ namespace Mem {
 						or (use_fstab and v_contains(fstab, mountpoint))
 						or (not use_fstab and only_physical and v_contains(fstypes, fstype))) {
 							found.push_back(mountpoint);
-							if (not v_contains(last_found, mountpoint)) redraw = true;
+							found_set.insert(mountpoint);
+							if (not last_set.contains(mountpoint)) redraw = true;
 
 							//? Save mountpoint, name, fstype, dev path and path to /sys/block stat file
 							if (not disks.contains(mountpoint)) {
@@ -2563,9 +2555,12 @@ namespace Mem {
 					}
 
 					//? Remove disks no longer mounted or filtered out
-					if (swap_disk and has_swap) found.push_back("swap");
+					if (swap_disk and has_swap) {
+						found.push_back("swap");
+						found_set.insert("swap");
+					}
 					for (auto it = disks.begin(); it != disks.end();) {
-						if (not v_contains(found, it->first))
+						if (not found_set.contains(it->first))
 							it = disks.erase(it);
 						else
 							it++;
@@ -2573,46 +2568,24 @@ namespace Mem {
 					if (found.size() != last_found.size()) redraw = true;
 					last_found = std::move(found);
 				}
-				else
-					throw std::runtime_error("Failed to get mounts from /etc/mtab and /proc/self/mounts");
-				diskread.close();
 
-				//? Get disk/partition stats
+				//? Get disk/partition stats, results come in from the pool one collect after the request
+				statvfs_pool.expire();
 				for (auto it = disks.begin(); it != disks.end(); ) {
 					auto &[mountpoint, disk] = *it;
 					if (v_contains(ignore_list, mountpoint) or disk.name == "swap") {
 						it = disks.erase(it);
 						continue;
 					}
-					if(auto promises_it = disks_stats_promises.find(mountpoint); promises_it != disks_stats_promises.end()){
-						auto& promise = promises_it->second;
-						if(promise.valid() &&
-						   promise.wait_for(0s) == std::future_status::timeout) {
-							++it;
-							continue;
-						}
-						auto promise_res = promises_it->second.get();
-						if(promise_res.second != -1){
+					if (auto res = statvfs_pool.take(mountpoint)) {
+						if (res->error != 0) {
 							ignore_list.push_back(mountpoint);
-							Logger::warning("Failed to get disk/partition stats for mount \"{}\" with statvfs error code: {}. Ignoring...", mountpoint, promise_res.second);
+							Logger::warning("Failed to get disk/partition stats for mount \"{}\" with statvfs error code: {}. Ignoring...", mountpoint, res->error);
 							it = disks.erase(it);
 							continue;
 						}
-						auto &updated_stats = promise_res.first;
-						disk.total = updated_stats.total;
-						disk.free = updated_stats.free;
-						disk.used = updated_stats.used;
-						disk.used_percent = updated_stats.used_percent;
-						disk.free_percent = updated_stats.free_percent;
-					}
-					disks_stats_promises[mountpoint] = async(std::launch::async, [mountpoint, free_priv]() -> pair<disk_info, int> {
-						struct statvfs vfs;
-						disk_info disk;
-						if (statvfs(mountpoint.c_str(), &vfs) < 0) {
-							return pair{disk, errno};
-						}
-						disk.total = vfs.f_blocks * vfs.f_frsize;
-						disk.free = (free_priv ? vfs.f_bfree : vfs.f_bavail) * vfs.f_frsize;
+						disk.total = res->total;
+						disk.free = free_priv ? res->free : res->avail;
 						disk.used = disk.total - disk.free;
 						if (disk.total != 0) {
 							disk.used_percent = round((double)disk.used * 100 / disk.total);
@@ -2621,10 +2594,12 @@ namespace Mem {
 							disk.used_percent = 0;
 							disk.free_percent = 0;
 						}
-						return pair{disk, -1};
-					});
+					}
+					statvfs_pool.request(mountpoint);
 					++it;
 				}
+				Runner::debug_stat("statvfs queued", statvfs_pool.queued());
+				Runner::debug_stat("statvfs timed out", statvfs_pool.timed_out());
 
 				//? Setup disks order in UI and add swap if enabled
 				mem.disks_order.clear();
@@ -2649,12 +2624,85 @@ namespace Mem {
 						if (not is_in(name, "/", "swap")) mem.disks_order.push_back(name);
 					#endif
 
-				//? Get disks IO
+				//? Get disks IO, the counters of all block devices are read from /proc/diskstats at once
+				static Procfs::DiskStats diskstats;
+				static std::array<char, 512> stat_buffer;
+				const bool have_diskstats = diskstats.read(Shared::procFd);
+				const int64_t elapsed_ms = std::llround((uptime - old_uptime) * 1000);
 				int64_t sectors_read, sectors_write, io_ticks, io_ticks_temp;
 				disk_ios = 0;
 				for (auto& [ignored, disk] : disks) {
-					if (disk.stat.empty() or access(disk.stat.c_str(), R_OK) != 0) continue;
-					if (disk.fstype == "zfs" && zfs_hide_datasets && zfs_collect_pool_total_stats(disk)) {
+					if (disk.stat.empty()) continue;
+					if (disk.fstype != "zfs") {
+						using Procfs::disk_stat;
+						//? Falls back to the stat file of the device when /proc/diskstats can't be read
+						std::optional<disk_stat> stat;
+						if (have_diskstats) {
+							if (disk.stat_name.empty()) disk.stat_name = disk.stat.parent_path().filename();
+							stat = diskstats.find(disk.stat_name, disk.stat_index);
+						}
+						else if (const auto file = Procfs::read_at(AT_FDCWD, disk.stat.c_str(), stat_buffer)) {
+							Procfs::Scanner scan { *file };
+							stat = Procfs::parse_disk_stat(scan);
+						}
+						if (not stat.has_value()) {
+							Logger::debug("Error in Mem::collect() : no I/O counters for {}", disk.stat);
+							continue;
+						}
+						disk_ios++;
+						const auto& counters = stat->values;
+						const bool first = disk.io_read.empty();
+
+						sectors_read = counters[disk_stat::sectors_read];
+						if (disk.io_read.empty())
+							disk.io_read.push_back(0);
+						else
+							disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
+						disk.old_io.at(0) = sectors_read;
+						while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+
+						sectors_write = counters[disk_stat::sectors_written];
+						if (disk.io_write.empty())
+							disk.io_write.push_back(0);
+						else
+							disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
+						disk.old_io.at(1) = sectors_write;
+						while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+
+						io_ticks = counters[disk_stat::io_ms];
+						if (uptime == old_uptime || disk.io_activity.empty())
+							disk.io_activity.push_back(0);
+						else
+							disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
+						disk.old_io.at(2) = io_ticks;
+						while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+
+						//? Counters of 32 bit kernels can wrap, a wrapped counter gives a zero rate for one collect.
+						//? Everything is computed in integers, await and queue depth in fixed-point hundredths.
+						const array<uint64_t, 4> ops = {
+							counters[disk_stat::reads], counters[disk_stat::writes], counters[disk_stat::queue_ms],
+							counters[disk_stat::read_ms] + counters[disk_stat::write_ms]
+						};
+						array<int64_t, 4> delta{};
+						if (not first and elapsed_ms > 0) {
+							for (size_t i = 0; i < ops.size(); i++)
+								delta[i] = ops[i] >= disk.old_ops[i] ? static_cast<int64_t>(ops[i] - disk.old_ops[i]) : 0;
+						}
+						disk.read_ops = elapsed_ms > 0 ? delta[0] * 1000 / elapsed_ms : 0;
+						disk.write_ops = elapsed_ms > 0 ? delta[1] * 1000 / elapsed_ms : 0;
+						disk.queue_ms = elapsed_ms > 0 ? delta[2] * 1000 / elapsed_ms : 0;
+
+						const int64_t completed = delta[0] + delta[1];
+						disk.io_await.push_back(completed > 0 ? delta[3] * 100 / completed : 0);
+						while (cmp_greater(disk.io_await.size(), width * 2)) disk.io_await.pop_front();
+						disk.io_queue.push_back(elapsed_ms > 0 ? delta[2] * 100 / elapsed_ms : 0);
+						while (cmp_greater(disk.io_queue.size(), width * 2)) disk.io_queue.pop_front();
+						disk.old_ops = ops;
+						continue;
+					}
+
+					if (access(disk.stat.c_str(), R_OK) != 0) continue;
+					if (zfs_hide_datasets && zfs_collect_pool_total_stats(disk)) {
 						disk_ios++;
 						continue;
 					}
@@ -2662,77 +2710,49 @@ namespace Mem {
 					if (diskread.good()) {
 						disk_ios++;
 						//? ZFS Pool Support
-						if (disk.fstype == "zfs") {
-							// skip first three lines
-							for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> io_ticks;
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> sectors_write; // nbytes written
-							if (disk.io_write.empty())
-								disk.io_write.push_back(0);
-							else
-								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1))));
-							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> io_ticks_temp;
-							io_ticks += io_ticks_temp;
-
-							// skip characters until '4' is reached, indicating data type 4, next value will be out target
-							diskread.ignore(numeric_limits<streamsize>::max(), '4');
-							diskread >> sectors_read; // nbytes read
-							if (disk.io_read.empty())
-								disk.io_read.push_back(0);
-							else
-								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0))));
-							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
-
-							if (disk.io_activity.empty())
-								disk.io_activity.push_back(0);
-							else
-								disk.io_activity.push_back(max((int64_t)0, (io_ticks - disk.old_io.at(2))));
-							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
-						} else {
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_read;
-							if (disk.io_read.empty())
-								disk.io_read.push_back(0);
-							else
-								disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
-							disk.old_io.at(0) = sectors_read;
-							while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
-
-							for (int i = 0; i < 3; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> sectors_write;
-							if (disk.io_write.empty())
-								disk.io_write.push_back(0);
-							else
-								disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
-							disk.old_io.at(1) = sectors_write;
-							while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
-
-							for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-							diskread >> io_ticks;
-							if (uptime == old_uptime || disk.io_activity.empty())
-								disk.io_activity.push_back(0);
-							else
-								disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
-							disk.old_io.at(2) = io_ticks;
-							while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
-						}
+						// skip first three lines
+						for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
+						// skip characters until '4' is reached, indicating data type 4, next value will be out target
+						diskread.ignore(numeric_limits<streamsize>::max(), '4');
+						diskread >> io_ticks;
+
+						// skip characters until '4' is reached, indicating data type 4, next value will be out target
+						diskread.ignore(numeric_limits<streamsize>::max(), '4');
+						diskread >> sectors_write; // nbytes written
+						if (disk.io_write.empty())
+							disk.io_write.push_back(0);
+						else
+							disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1))));
+						disk.old_io.at(1) = sectors_write;
+						while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+
+						// skip characters until '4' is reached, indicating data type 4, next value will be out target
+						diskread.ignore(numeric_limits<streamsize>::max(), '4');
+						diskread >> io_ticks_temp;
+						io_ticks += io_ticks_temp;
+
+						// skip characters until '4' is reached, indicating data type 4, next value will be out target
+						diskread.ignore(numeric_limits<streamsize>::max(), '4');
+						diskread >> sectors_read; // nbytes read
+						if (disk.io_read.empty())
+							disk.io_read.push_back(0);
+						else
+							disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0))));
+						disk.old_io.at(0) = sectors_read;
+						while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+
+						if (disk.io_activity.empty())
+							disk.io_activity.push_back(0);
+						else
+							disk.io_activity.push_back(clamp((int64_t)(io_ticks - disk.old_io.at(2)), (int64_t)0, (int64_t)100));
+						disk.old_io.at(2) = io_ticks;
+						while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
 					} else {
 						Logger::debug("Error in Mem::collect() : when opening {}", disk.stat);
 					}
 					diskread.close();
 				}
+				Runner::debug_stat("diskstats devices", diskstats.size());
 				old_uptime = uptime;
 			}
 			catch (const std::exception& e) {
@@ -2868,7 +2888,7 @@ namespace Mem {
 		if (disk.io_activity.empty())
 			disk.io_activity.push_back(0);
 		else
-			disk.io_activity.push_back(max((int64_t)0, (io_ticks_total - disk.old_io.at(2))));
+			disk.io_activity.push_back(clamp((int64_t)(io_ticks_total - disk.old_io.at(2)), (int64_t)0, (int64_t)100));
 		disk.old_io.at(2) = io_ticks_total;
 		while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
 
@@ -3085,7 +3105,8 @@ namespace Net {
 namespace Proc {
 
 	vector<proc_info> current_procs;
-	std::unordered_map<string, string> uid_user;
+	vector<proc_row> proc_table;
+	std::unordered_map<uid_t, string> uid_user;
 	string current_sort;
 	string current_filter;
 	bool current_rev{};
@@ -3101,11 +3122,256 @@ namespace Proc {
 
 	detail_container detailed;
 	constexpr size_t KTHREADD = 2;
+
+	//? Maps pid to position in current_procs, positions are only valid until current_procs is sorted
+	std::unordered_map<size_t, size_t> pid_index;
+	uint64_t generation{};
+
+	void rebuild_pid_index() {
+		pid_index.clear();
+		pid_index.reserve(current_procs.size());
+		for (size_t i = 0; i < current_procs.size(); i++) pid_index.emplace(current_procs[i].pid, i);
+	}
+
+	//? State for one process passed from the read phase to the merge phase of collect()
+	struct proc_job {
+		size_t index;
+		bool no_cache;
+		bool complete{};
+		bool is_kernel{};
+		bool cmd_deferred{};
+		bool stat_batched{};
+		std::optional<uid_t> uid{};
+		std::optional<Procfs::pid_stat> stat{};
+	};
+	vector<proc_job> proc_jobs;
+
+	//? Batched reading of /proc/[pid]/stat files with io_uring when proc_io_uring is enabled
+	Procfs::UringReader uring;
+	bool uring_failed{};
+	uint64_t uring_reads{};
+	constexpr unsigned uring_batch = 256;
+	constexpr size_t stat_buf_size = 1024;
+
+	//? Read and parse /proc/[pid]/stat for all jobs with io_uring, jobs left with stat_batched unset are read one by one later
+	void batch_read_stats() {
+		if (uring_failed) return;
+		if (not uring.init(uring_batch)) {
+			Logger::warning("io_uring not available, reading process files with plain system calls");
+			uring_failed = true;
+			return;
+		}
+
+		static vector<char> buffers(uring_batch * stat_buf_size);
+		static vector<array<char, 32>> paths(uring_batch);
+		static vector<Procfs::batch_read> reads;
+
+		for (size_t offset = 0; offset < proc_jobs.size(); offset += uring_batch) {
+			const size_t count = min<size_t>(uring_batch, proc_jobs.size() - offset);
+			reads.clear();
+			for (size_t i = 0; i < count; i++) {
+				*fmt::format_to_n(paths[i].data(), paths[i].size() - 1, "{}/stat", current_procs[proc_jobs[offset + i].index].pid).out = '\0';
+				reads.push_back({ paths[i].data(), std::span{buffers}.subspan(i * stat_buf_size, stat_buf_size) });
+			}
+			if (not uring.read(Shared::procFd, reads)) {
+				Logger::warning("io_uring read failed, reading process files with plain system calls");
+				uring_failed = true;
+				return;
+			}
+			//? A process that exited has no stat file, other errors are retried with a plain read
+			for (size_t i = 0; i < count; i++) {
+				auto& job = proc_jobs[offset + i];
+				const int result = reads[i].result;
+				if (result > 0)
+					job.stat = Procfs::parse_pid_stat({ reads[i].buffer.data(), static_cast<size_t>(result) });
+				job.stat_batched = (result > 0 or result == -ENOENT or result == -ESRCH);
+			}
+			uring_reads += count;
+		}
+		Runner::debug_stat("uring stat reads", uring_reads);
+	}
+
+	//? Rebuild uid_user from a passwd file read in one go, the first entry for a uid wins
+	bool read_passwd(const fs::path& passwd_path) {
+		ifstream pread(passwd_path, std::ios::binary);
+		if (not pread.good()) return false;
+		const string content { std::istreambuf_iterator<char>(pread), {} };
+
+		uid_user.clear();
+		for (std::string_view rest = content; not rest.empty();) {
+			const auto line_end = std::min(rest.find('\n'), rest.size());
+			const auto line = rest.substr(0, line_end);
+			rest.remove_prefix(std::min(line_end + 1, rest.size()));
+
+			//? name:password:uid:...
+			const auto name_end = line.find(':');
+			if (name_end == std::string_view::npos or name_end == 0) continue;
+			const auto uid_start = line.find(':', name_end + 1);
+			if (uid_start == std::string_view::npos) continue;
+			const auto uid_str = line.substr(uid_start + 1, line.find(':', uid_start + 1) - uid_start - 1);
+			uid_t uid;
+			const auto [ptr, ec] = std::from_chars(uid_str.data(), uid_str.data() + uid_str.size(), uid);
+			if (ec != std::errc{} or ptr != uid_str.data() + uid_str.size()) continue;
+			uid_user.try_emplace(uid, line.substr(0, name_end));
+		}
+		return true;
+	}
+
+	//? Return the user name for <uid>, uids missing from /etc/passwd are looked up once with getpwuid and cached
+	auto uid_to_user(uid_t uid) -> const string& {
+		if (auto found = uid_user.find(uid); found != uid_user.end()) return found->second;
+		string name;
+	#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
+		if (struct passwd* udet = getpwuid(uid); udet != nullptr and udet->pw_name != nullptr) {
+			name = udet->pw_name;
+		}
+	#endif
+		if (name.empty()) name = to_string(uid);
+		return uid_user.emplace(uid, std::move(name)).first->second;
+	}
+
+	//? Read /proc/[pid]/cmdline into proc.cmd, arguments are separated by null characters and only the first 1000 characters are kept
+	bool read_cmdline(proc_info& proc) {
+		std::array<char, 1000> buf;
+		std::array<char, 32> path;
+		*fmt::format_to_n(path.data(), path.size() - 1, "{}/cmdline", proc.pid).out = '\0';
+		auto cmdline = Procfs::read_at(Shared::procFd, path.data(), buf);
+		if (not cmdline.has_value()) return false;
+		proc.cmd = *cmdline;
+		rng::replace(proc.cmd, '\0', ' ');
+		if (proc.cmd.ends_with(' ')) proc.cmd.pop_back();
+		return true;
+	}
+
+	//? Pids of live processes kept up to date from proc connector events when proc_events is enabled
+	std::unordered_set<size_t> live_pids;
+	vector<size_t> listed_pids;
+	uint64_t last_pid_scan{};
+	uint64_t pid_rescans{};
+	bool proc_events_failed{};
+	constexpr uint64_t pid_rescan_ms = 60'000;
+
+	//? Add pids of all processes in /proc to <pids>
+	void scan_pids(vector<size_t>& pids) {
+		for (const auto& d: fs::directory_iterator(Shared::procPath)) {
+			const string pid_str = d.path().filename();
+			if (not isdigit(pid_str[0])) continue;
+			pids.push_back(stoul(pid_str));
+		}
+	}
+
+	//? List pids from proc connector events if enabled and permitted, otherwise by scanning /proc.
+	//? Returns true if the list came from events, which can hold pids of processes that have already exited.
+	bool list_pids(vector<size_t>& pids) {
+		pids.clear();
+		bool use_events = Config::getB("proc_events") and not proc_events_failed;
+		if (use_events and not ProcEvents::start()) {
+			Logger::warning("Proc connector not available (needs CAP_NET_ADMIN), falling back to scanning /proc");
+			proc_events_failed = true;
+			use_events = false;
+		}
+		else if (not use_events and ProcEvents::active()) {
+			ProcEvents::stop();
+			live_pids.clear();
+		}
+
+		if (not use_events) {
+			scan_pids(pids);
+			return false;
+		}
+
+		const bool synced = ProcEvents::poll(live_pids);
+		if (not ProcEvents::active()) {
+			Logger::warning("Proc connector refused listening (needs CAP_NET_ADMIN), falling back to scanning /proc");
+			proc_events_failed = true;
+			live_pids.clear();
+			scan_pids(pids);
+			return false;
+		}
+
+		//? Rescan if events were missed and every pid_rescan_ms to catch processes whose exit event was lost
+		if (not synced or time_ms() - last_pid_scan >= pid_rescan_ms) {
+			scan_pids(pids);
+			live_pids.clear();
+			live_pids.insert(pids.begin(), pids.end());
+			last_pid_scan = time_ms();
+			pid_rescans++;
+		}
+		else {
+			pids.assign(live_pids.begin(), live_pids.end());
+		}
+		Runner::debug_stat("proc events", ProcEvents::last_count());
+		Runner::debug_stat("pid rescans", pid_rescans);
+		return true;
+	}
+
+	//? Pids of processes with a deferred cmdline read when proc_lazy_cmdline is enabled
+	std::unordered_set<size_t> pending_cmd;
+	uint64_t cmd_reads_avoided{};
+
+	//? Read cmdline for <proc> if it was deferred
+	void load_cmdline(proc_info& proc) {
+		if (pending_cmd.erase(proc.pid) == 0) return;
+		read_cmdline(proc);
+		set_short_cmd(proc);
+	}
+
+	//? Read all deferred cmdlines, needed before filtering or sorting on the command
+	void load_all_cmdlines() {
+		if (pending_cmd.empty()) return;
+		for (auto& p : current_procs) {
+			load_cmdline(p);
+			if (pending_cmd.empty()) break;
+		}
+	}
+
+	//? Read deferred cmdlines for processes around the rows shown in the process box
+	void load_visible_cmdlines(bool tree) {
+		if (pending_cmd.empty()) return;
+		const int rows = max(1, Proc::select_max);
+		const int start = Config::getI("proc_start");
+		const int followed_pid = Config::getB("follow_process") ? Config::getI("followed_pid") : -1;
+		const int restore_pid = Config::getI("restore_detailed_pid");
+
+		//? Find position of a followed process first since the process box will move there
+		int center = -1;
+		if (followed_pid > 0 or restore_pid > 0) {
+			const size_t find_pid = restore_pid > 0 ? restore_pid : followed_pid;
+			for (int n = 0; const auto& p : current_procs) {
+				if (p.filtered or (tree and p.tree_index == current_procs.size())) continue;
+				if (p.pid == find_pid) {
+					center = n;
+					break;
+				}
+				n++;
+			}
+		}
+
+		//? Include one screen above and below to cover scrolling before the next update
+		const int first = (center >= 0 ? center : start) - rows;
+		const int last = (center >= 0 ? center : start) + 2 * rows;
+		for (int n = 0; auto& p : current_procs) {
+			if (p.filtered or (tree and p.tree_index == current_procs.size())) continue;
+			if (n >= first) load_cmdline(p);
+			if (++n >= last) break;
+		}
+	}
+
+	//? Workers for reading /proc/[pid] files, the runner thread also takes part so the pool holds one thread less than used.
+	//? The pool only grows, so a process count hovering around a step of collect_threads() doesn't respawn workers every update.
+	Tools::ThreadPool read_pool;
+	constexpr size_t procs_per_thread = 512;
+
+	//? Number of threads to read /proc/[pid] files with, a proc_collect_threads value of 0 scales with process and core count
+	size_t collect_threads(size_t procs, long core_count) {
+		if (const auto threads = Config::getI("proc_collect_threads"); threads > 0) return threads;
+		return std::clamp<size_t>(procs / procs_per_thread, 1, core_count);
+	}
 	static std::unordered_set<size_t> kernels_procs = {KTHREADD};
 	static std::unordered_set<size_t> dead_procs;
 
 	//* Get detailed info for selected process
-	static void _collect_details(const size_t pid, const uint64_t uptime, vector<proc_info>& procs) {
+	static void _collect_details(const size_t pid, const long core_count, const uint64_t uptime, vector<proc_info>& procs) {
 		fs::path pid_path = Shared::procPath / std::to_string(pid);
 
 		if (pid != detailed.last_pid) {
@@ -3116,10 +3382,11 @@ namespace Proc {
 
 		//? Copy proc_info for process from proc vector
 		auto p_info = rng::find(procs, pid, &proc_info::pid);
+		if (p_info != procs.end()) load_cmdline(*p_info);
 		detailed.entry = *p_info;
 
 		//? Update cpu percent deque for process cpu graph
-		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
+		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= core_count;
 		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
 		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
 
@@ -3203,16 +3470,18 @@ namespace Proc {
 	}
 
 	//* Collects and sorts process information from /proc
-	auto collect(bool no_update) -> vector<proc_info>& {
+	auto collect(bool no_update, long core_count) -> vector<proc_info>& {
 		if (Runner::stopping) return current_procs;
 		const auto& sorting = Config::getS("proc_sorting");
 		auto reverse = Config::getB("proc_reversed");
 		const auto& filter = Config::getS("proc_filter");
+		const auto& compiled_filter = get_compiled_filter(filter);
 		auto per_core = Config::getB("proc_per_core");
 		auto should_filter_kernel = Config::getB("proc_filter_kernel");
 		auto tree = Config::getB("proc_tree");
 		auto show_detailed = Config::getB("show_detailed");
 		const auto pause_proc_list = Config::getB("pause_proc_list");
+		const auto lazy_cmdline = Config::getB("proc_lazy_cmdline");
 		const size_t detailed_pid = Config::getI("detailed_pid");
 		bool should_filter = current_filter != filter;
 		if (should_filter) current_filter = filter;
@@ -3224,26 +3493,23 @@ namespace Proc {
 		}
 		if (tree_mode_change) is_tree_mode = tree;
 		ifstream pread;
-		string long_string;
-		string short_str;
-
-		static vector<size_t> found;
 
 		const double uptime = system_uptime();
 
-		const int cmult = (per_core) ? Shared::coreCount : 1;
+		const int cmult = (per_core) ? core_count : 1;
 		bool got_detailed = false;
 
 		static size_t proc_clear_count{};
 
 		//* Use pids from last update if only changing filter, sorting or tree options
 		if (no_update and not current_procs.empty()) {
-			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, round(uptime), current_procs);
+			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, core_count, round(uptime), current_procs);
 		}
 		//* ---------------------------------------------Collection start----------------------------------------------
 		else {
 			should_filter = true;
-			found.clear();
+			++generation;
+			rebuild_pid_index();
 
 			//? First make sure kernel proc cache is cleared.
 			if (should_filter_kernel and ++proc_clear_count >= 256) {
@@ -3255,237 +3521,170 @@ namespace Proc {
 			}
 
 			auto totalMem = Mem::get_totalMem();
-			int totalMem_len = to_string(totalMem >> 10).size();
 
 			//? Update uid_user map if /etc/passwd changed since last run
 			if (not Shared::passwd_path.empty() and fs::last_write_time(Shared::passwd_path) != passwd_time) {
-				string r_uid, r_user;
 				passwd_time = fs::last_write_time(Shared::passwd_path);
-				uid_user.clear();
-				pread.open(Shared::passwd_path);
-				if (pread.good()) {
-					while (pread.good()) {
-						getline(pread, r_user, ':');
-						pread.ignore(SSmax, ':');
-						getline(pread, r_uid, ':');
-						if (uid_user.contains(r_uid)) break;
-						uid_user[r_uid] = r_user;
-						pread.ignore(SSmax, '\n');
-					}
-				}
-				else {
-					Shared::passwd_path.clear();
-				}
-				pread.close();
+				if (not read_passwd(Shared::passwd_path)) Shared::passwd_path.clear();
 			}
 
 			//? Get cpu total times from /proc/stat up to the guest field
-			cputimes = 0;
-			pread.open(Shared::procPath / "stat");
-			if (pread.good()) {
-				pread.ignore(SSmax, ' ');
-				int i = 0;
-				for (uint64_t times; i < 8 and pread >> times; cputimes += times, i++);
+			std::array<char, 4096> stat_buf;
+			if (auto stat = Procfs::read_at(Shared::procFd, "stat", stat_buf); stat.has_value()) {
+				Procfs::Scanner scan { *stat };
+				const auto all = Procfs::parse_cpu_stat(scan);
+				cputimes = all.has_value() ? all->total() : 0;
 			}
 			else throw std::runtime_error("Failure to read /proc/stat");
-			pread.close();
 
-			//? Iterate over all pids in /proc
-			for (const auto& d: fs::directory_iterator(Shared::procPath)) {
+			//? Iterate over all pids and find or add their entries in current_procs
+			const bool from_events = list_pids(listed_pids);
+			proc_jobs.clear();
+			for (const size_t pid : listed_pids) {
 				if (Runner::stopping)
 					return current_procs;
 
-				if (pread.is_open()) pread.close();
-
-				const string pid_str = d.path().filename();
-				if (not isdigit(pid_str[0])) continue;
-
-				const size_t pid = stoul(pid_str);
-
 				if (should_filter_kernel and kernels_procs.contains(pid)) {
 					continue;
 				}
 
-				found.push_back(pid);
-
 				//? Check if pid already exists in current_procs
-				auto find_old = rng::find(current_procs, pid, &proc_info::pid);
+				auto find_old = pid_index.find(pid);
 				bool no_cache{};
 				//? Only add new processes if not paused
-				if (find_old == current_procs.end()) {
+				if (find_old == pid_index.end()) {
 					if (not pause_proc_list) {
+						find_old = pid_index.emplace(pid, current_procs.size()).first;
 						current_procs.push_back({pid});
-						find_old = current_procs.end() - 1;
 						no_cache = true;
 					}
 					else continue;
 				}
 				else if (dead_procs.contains(pid)) continue;
 
-				auto& new_proc = *find_old;
-
-				//? Get program name, command and username
-				if (no_cache) {
-					pread.open(d.path() / "comm");
-					if (not pread.good()) continue;
-					getline(pread, new_proc.name);
-					pread.close();
-					//? Check for whitespace characters in name and set offset to get correct fields from stat file
-					new_proc.name_offset = rng::count(new_proc.name, ' ');
-
-					pread.open(d.path() / "cmdline");
-					if (not pread.good()) continue;
-					long_string.clear();
-					while(getline(pread, long_string, '\0')) {
-						new_proc.cmd += long_string + ' ';
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							break;
-						}
-					}
-					pread.close();
-					if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
-
-					pread.open(d.path() / "status");
-					if (not pread.good()) continue;
-					string uid;
-					string line;
-					while (pread.good()) {
-						getline(pread, line, ':');
-						if (line == "Uid") {
-							pread.ignore();
-							getline(pread, uid, '\t');
-							break;
-						} else {
-							pread.ignore(SSmax, '\n');
-						}
-					}
-					pread.close();
-					if (uid_user.contains(uid)) {
-						new_proc.user = uid_user.at(uid);
-					}
-					else {
-					#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
-						try {
-							struct passwd* udet;
-							udet = getpwuid(stoi(uid));
-							if (udet != nullptr and udet->pw_name != nullptr) {
-								new_proc.user = string(udet->pw_name);
-							}
-							else {
-								new_proc.user = uid;
-							}
-						}
-						catch (...) { new_proc.user = uid; }
-					#else
-						new_proc.user = uid;
-					#endif
-					}
-				}
+				current_procs[find_old->second].generation = generation;
+				proc_jobs.push_back({find_old->second, no_cache});
+			}
 
-				//? Parse /proc/[pid]/stat
-				pread.open(d.path() / "stat");
-				if (not pread.good()) continue;
+			if (Config::getB("proc_io_uring")) batch_read_stats();
 
-				const auto& offset = new_proc.name_offset;
-				short_str.clear();
-				int x = 0, next_x = 3;
-				uint64_t cpu_t = 0;
-				try {
-					for (;;) {
-						while (pread.good() and ++x < next_x + offset) pread.ignore(SSmax, ' ');
-						if (not pread.good()) break;
-						else getline(pread, short_str, ' ');
-
-						switch (x-offset) {
-							case 3: //? Process state
-								new_proc.state = short_str.at(0);
-								if (new_proc.ppid != 0) next_x = 14;
-								continue;
-							case 4: //? Parent pid
-								new_proc.ppid = stoull(short_str);
-								next_x = 14;
-								continue;
-							case 14: //? Process utime
-								cpu_t = stoull(short_str);
-								continue;
-							case 15: //? Process stime
-								cpu_t += stoull(short_str);
-								next_x = 19;
-								continue;
-							case 19: //? Nice value
-								new_proc.p_nice = stoll(short_str);
-								continue;
-							case 20: //? Number of threads
-								new_proc.threads = stoull(short_str);
-								if (new_proc.cpu_s == 0) {
-									next_x = 22;
-									new_proc.cpu_t = cpu_t;
-								}
-								else
-									next_x = 24;
-								continue;
-							case 22: //? Get cpu seconds if missing
-								new_proc.cpu_s = stoull(short_str);
-								next_x = 24;
-								continue;
-							case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
-								if (cmp_greater(short_str.size(), totalMem_len))
-									new_proc.mem = totalMem;
-								else
-									new_proc.mem = stoull(short_str) * Shared::pageSize;
-						}
-						break;
-					}
+			//? Read and parse files in /proc/[pid], only touches the jobs own entry in current_procs so jobs can run in parallel
+			auto read_proc = [&](size_t job_index) {
+				if (Runner::stopping) return;
+				auto& job = proc_jobs[job_index];
+				auto& new_proc = current_procs[job.index];
+				const size_t pid = new_proc.pid;
+
+				std::array<char, 4096> read_buf;
+				std::array<char, 48> pid_path;
+				auto pid_file = [&pid_path, pid](std::string_view file) -> const char* {
+					auto end = fmt::format_to_n(pid_path.data(), pid_path.size() - 1, "{}/{}", pid, file).out;
+					*end = '\0';
+					return pid_path.data();
+				};
+
+				//? Get program name, command and uid
+				if (job.no_cache) {
+					auto comm = Procfs::read_at(Shared::procFd, pid_file("comm"), read_buf);
+					if (not comm.has_value()) return;
+					new_proc.name = comm->substr(0, comm->find('\n'));
 
+					if (lazy_cmdline) job.cmd_deferred = true;
+					else if (not read_cmdline(new_proc)) return;
+
+					auto status = Procfs::read_at(Shared::procFd, pid_file("status"), read_buf);
+					if (not status.has_value()) return;
+					job.uid = Procfs::parse_status_uid(*status);
 				}
-				catch (const std::invalid_argument&) { continue; }
-				catch (const std::out_of_range&) { continue; }
 
-				pread.close();
+				//? Parse /proc/[pid]/stat unless already read in a batch
+				if (not job.stat_batched) {
+					auto stat_data = Procfs::read_at(Shared::procFd, pid_file("stat"), read_buf);
+					if (not stat_data.has_value()) return;
+					job.stat = Procfs::parse_pid_stat(*stat_data);
+				}
+				const auto& stat = job.stat;
+				if (not stat.has_value()) return;
 
-				if (should_filter_kernel and new_proc.ppid == KTHREADD) {
-					kernels_procs.emplace(new_proc.pid);
-					found.pop_back();
+				new_proc.state = stat->state;
+				if (new_proc.ppid == 0) new_proc.ppid = stat->ppid;
+				new_proc.p_nice = stat->nice;
+				new_proc.threads = stat->threads;
+				const uint64_t cpu_t = stat->utime + stat->stime;
+				if (new_proc.cpu_s == 0) {
+					new_proc.cpu_t = cpu_t;
+					new_proc.cpu_s = stat->starttime;
 				}
+				//? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
+				new_proc.mem = (stat->rss > totalMem / Shared::pageSize) ? totalMem : stat->rss * Shared::pageSize;
 
-				if (x-offset < 24) continue;
+				job.is_kernel = should_filter_kernel and new_proc.ppid == KTHREADD;
 
 				//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
 				if (new_proc.mem >= totalMem) {
-					pread.open(d.path() / "statm");
-					if (not pread.good()) continue;
-					pread.ignore(SSmax, ' ');
-					pread >> new_proc.mem;
+					auto statm = Procfs::read_at(Shared::procFd, pid_file("statm"), read_buf);
+					if (not statm.has_value()) return;
+					Procfs::Scanner scan { *statm };
+					scan.skip(1);
+					scan.next(new_proc.mem);
 					new_proc.mem *= Shared::pageSize;
-					pread.close();
 				}
 
 				//? Process cpu usage since last update
-				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * core_count);
 
 				//? Process cumulative cpu usage since process start
 				new_proc.cpu_c = (double)cpu_t / max(1.0, (uptime * Shared::clkTck) - new_proc.cpu_s);
 
 				//? Update cached value with latest cpu times
 				new_proc.cpu_t = cpu_t;
+				job.complete = true;
+			};
+
+			if (const size_t threads = collect_threads(proc_jobs.size(), core_count); threads > 1) {
+				if (read_pool.size() < threads - 1) read_pool.resize(threads - 1);
+				read_pool.parallel_for(proc_jobs.size(), read_proc, threads);
+			}
+			else
+				for (size_t i = 0; i < proc_jobs.size(); i++) read_proc(i);
+
+			if (Runner::stopping)
+				return current_procs;
 
-				if (show_detailed and not got_detailed and new_proc.pid == detailed_pid) {
+			//? Merge results that depend on shared state
+			for (const auto& job : proc_jobs) {
+				auto& new_proc = current_procs[job.index];
+
+				if (job.uid.has_value()) new_proc.user = uid_to_user(*job.uid);
+				if (job.cmd_deferred) pending_cmd.insert(new_proc.pid);
+
+				if (job.is_kernel) {
+					kernels_procs.emplace(new_proc.pid);
+					new_proc.generation = 0;
+				}
+				//? Failed reads of a pid from the event list means the exit event hasn't been received yet
+				else if (from_events and not job.complete) {
+					live_pids.erase(new_proc.pid);
+					new_proc.generation = 0;
+				}
+
+				if (show_detailed and not got_detailed and job.complete and new_proc.pid == detailed_pid) {
 					got_detailed = true;
 				}
 			}
 
 			//? Clear dead processes from current_procs and remove kernel processes if enabled and not paused
 			if (not pause_proc_list) {
-				auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return not v_contains(found, element.pid); });
-				current_procs.erase(eraser.begin(), eraser.end());
+				std::erase_if(current_procs, [&](const auto& element){ return element.generation != generation; });
+				rebuild_pid_index();
+				cmd_reads_avoided += std::erase_if(pending_cmd, [](size_t pid) { return not pid_index.contains(pid); });
 				if (!dead_procs.empty()) dead_procs.clear();
 			}
 			//? Set correct state of dead processes if paused
 			else {
 				const bool keep_dead_proc_usage = Config::getB("keep_dead_proc_usage");
 				for (auto& r : current_procs) {
-					if (rng::find(found, r.pid) == found.end()) {
+					if (r.generation != generation) {
 						if (r.state != 'X') r.death_time = round(uptime) - (r.cpu_s / Shared::clkTck);
 						r.state = 'X';
 						dead_procs.emplace(r.pid);
@@ -3500,7 +3699,7 @@ namespace Proc {
 
 			//? Update the details info box for process if active
 			if (show_detailed and got_detailed) {
-				_collect_details(detailed_pid, round(uptime), current_procs);
+				_collect_details(detailed_pid, core_count, round(uptime), current_procs);
 			}
 			else if (show_detailed and not got_detailed and detailed.status != "Dead") {
 				detailed.status = "Dead";
@@ -3511,12 +3710,19 @@ namespace Proc {
 		}
 		//* ---------------------------------------------Collection done-----------------------------------------------
 
+		//? Filtering and sorting by command needs all command lines
+		if (not lazy_cmdline or not filter.empty() or sorting == "command") load_all_cmdlines();
+
+		//? The filter, sort and tree passes work on packed rows of the hot fields and read strings from current_procs through the row slots,
+		//? current_procs itself is only reordered once when the rows are applied
+		fill_table(proc_table, current_procs);
+
 		//* Match filter if defined
 		if (should_filter) {
 			filter_found = 0;
-			for (auto& p : current_procs) {
+			for (auto& p : proc_table) {
 				if (not tree and not filter.empty()) {
-					if (!matches_filter(p, filter)) {
+					if (!matches_filter(current_procs[p.slot], compiled_filter)) {
 						p.filtered = true;
 						filter_found++;
 					} else {
@@ -3530,7 +3736,7 @@ namespace Proc {
 
 		//* Sort processes
 		if ((sorted_change or tree_mode_change) or (not no_update and not pause_proc_list)) {
-			proc_sorter(current_procs, sorting, reverse, tree);
+			proc_sorter(proc_table, current_procs, sorting, reverse, tree);
 		}
 
 		//* Generate tree view if enabled
@@ -3538,12 +3744,12 @@ namespace Proc {
 			bool locate_selection = false;
 
 			if (toggle_children != -1) {
-				auto collapser = rng::find(current_procs, toggle_children, &proc_info::pid);
-				if (collapser != current_procs.end()){
-					for (auto& p : current_procs) {
+				auto collapser = rng::find(proc_table, toggle_children, &proc_row::pid);
+				if (collapser != proc_table.end()){
+					for (auto& p : proc_table) {
 						if (p.ppid == collapser->pid) {
-							auto child = rng::find(current_procs, p.pid, &proc_info::pid);
-							if (child != current_procs.end()){
+							auto child = rng::find(proc_table, p.pid, &proc_row::pid);
+							if (child != proc_table.end()){
 								child->collapsed = not child->collapsed;
 							}
 						}
@@ -3554,8 +3760,8 @@ namespace Proc {
 			}
 
 			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
-				auto collapser = rng::find(current_procs, find_pid, &proc_info::pid);
-				if (collapser != current_procs.end()) {
+				auto collapser = rng::find(proc_table, find_pid, &proc_row::pid);
+				if (collapser != proc_table.end()) {
 					if (collapse == expand) {
 						collapser->collapsed = not collapser->collapsed;
 					}
@@ -3571,7 +3777,7 @@ namespace Proc {
 			}
 
 			if (collapse_all != -1) {
-				toggle_tree_collapse(current_procs);
+				toggle_tree_collapse(proc_table);
 				collapse_all = -1;
 				if (Config::ints.at("proc_selected") > 0) locate_selection = true;
 			}
@@ -3579,48 +3785,56 @@ namespace Proc {
 			if (should_filter or not filter.empty()) filter_found = 0;
 
 			vector<tree_proc> tree_procs;
-			tree_procs.reserve(current_procs.size());
+			tree_procs.reserve(proc_table.size());
 
 			if (!pause_proc_list) {
-				for (auto& p : current_procs) {
-					if (not v_contains(found, p.ppid)) p.ppid = 0;
+				for (auto& p : proc_table) {
+					if (not pid_index.contains(p.ppid)) p.ppid = 0;
 				}
 			}
 
 			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(current_procs, rng::less{}, & proc_info::ppid);
+			rng::stable_sort(proc_table, rng::less{}, & proc_row::ppid);
 
 			//? Auto-collapse processes with many children when entering tree mode
-			_auto_collapse_oversized(current_procs, tree_mode_change);
+			_auto_collapse_oversized(proc_table, tree_mode_change);
 
 			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
+			for (auto& p : rng::equal_range(proc_table, proc_table.at(0).ppid, rng::less{}, &proc_row::ppid)) {
+				_tree_gen(p, proc_table, current_procs, tree_procs, 0, false, compiled_filter, false, no_update, should_filter);
 			}
 
 			//? Recursive sort over tree structure to account for collapsed processes in the tree
 			int index = 0;
-			tree_sort(tree_procs, sorting, reverse, (pause_proc_list and not (sorted_change or tree_mode_change)), index, current_procs.size());
+			tree_sort(tree_procs, sorting, reverse, (pause_proc_list and not (sorted_change or tree_mode_change)), index, proc_table.size());
 
 			//? Recursive construction of ASCII tree prefixes.
 			for (auto t = tree_procs.begin(); t != tree_procs.end(); ++t) {
-				_collect_prefixes(*t, t == tree_procs.end() - 1);
+				_collect_prefixes(*t, current_procs, t == tree_procs.end() - 1);
 			}
 
 			//? Final sort based on tree index
-			rng::stable_sort(current_procs, rng::less {}, &proc_info::tree_index);
+			rng::stable_sort(proc_table, rng::less {}, &proc_row::tree_index);
 
 			//? Move current selection/view to the selected process when collapsing/expanding in the tree
 			if (locate_selection) {
-				int loc = rng::find(current_procs, Proc::selected_pid, &proc_info::pid)->tree_index;
+				int loc = rng::find(proc_table, Proc::selected_pid, &proc_row::pid)->tree_index;
 				if (Config::ints.at("proc_start") >= loc or Config::ints.at("proc_start") <= loc - Proc::select_max)
 					Config::ints.at("proc_start") = max(0, loc - 1);
 				Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
 			}
 		}
 
+		apply_table(proc_table, current_procs);
+
 		numpids = (int)current_procs.size() - filter_found;
 
+		if (lazy_cmdline) {
+			load_visible_cmdlines(tree);
+			Runner::debug_stat("cmdline deferred", pending_cmd.size());
+			Runner::debug_stat("cmdline avoided", cmd_reads_avoided);
+		}
+
 		return current_procs;
 	}
 }
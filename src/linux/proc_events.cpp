@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "proc_events.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ProcEvents {
+	namespace {
+		int sock = -1;
+		bool synced{};
+		size_t count{};
+
+		bool send_op(proc_cn_mcast_op op) {
+			alignas(nlmsghdr) std::array<char, NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))> buf{};
+			auto* nlh = reinterpret_cast<nlmsghdr*>(buf.data());
+			nlh->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+			nlh->nlmsg_type = NLMSG_DONE;
+			nlh->nlmsg_pid = 0;
+
+			auto* msg = static_cast<cn_msg*>(NLMSG_DATA(nlh));
+			msg->id.idx = CN_IDX_PROC;
+			msg->id.val = CN_VAL_PROC;
+			msg->len = sizeof(proc_cn_mcast_op);
+			std::memcpy(msg->data, &op, sizeof(op));
+
+			return send(sock, nlh, nlh->nlmsg_len, 0) == static_cast<ssize_t>(nlh->nlmsg_len);
+		}
+	}
+
+	bool start() {
+		if (sock >= 0) return true;
+
+		sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+		if (sock < 0) return false;
+
+		sockaddr_nl addr{};
+		addr.nl_family = AF_NETLINK;
+		addr.nl_groups = CN_IDX_PROC;
+		if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 or not send_op(PROC_CN_MCAST_LISTEN)) {
+			close(sock);
+			sock = -1;
+			return false;
+		}
+		synced = false;
+		return true;
+	}
+
+	void stop() {
+		if (sock < 0) return;
+		send_op(PROC_CN_MCAST_IGNORE);
+		close(sock);
+		sock = -1;
+	}
+
+	bool active() noexcept {
+		return sock >= 0;
+	}
+
+	bool poll(std::unordered_set<size_t>& pids) {
+		count = 0;
+		if (sock < 0) return false;
+
+		alignas(nlmsghdr) std::array<char, 16384> buf;
+		for (;;) {
+			sockaddr_nl from{};
+			socklen_t from_len = sizeof(from);
+			const ssize_t len = recvfrom(sock, buf.data(), buf.size(), 0, reinterpret_cast<sockaddr*>(&from), &from_len);
+			if (len < 0) {
+				if (errno == EINTR) continue;
+				//? Events were dropped by the kernel, keep reading to empty the queue before the caller rescans
+				if (errno == ENOBUFS) {
+					synced = false;
+					continue;
+				}
+				break;
+			}
+			//? Only trust messages sent by the kernel
+			if (from.nl_pid != 0) continue;
+
+			size_t remaining = len;
+			for (auto* nlh = reinterpret_cast<nlmsghdr*>(buf.data()); NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+				if (nlh->nlmsg_type == NLMSG_ERROR or nlh->nlmsg_type == NLMSG_NOOP) continue;
+				const auto* msg = static_cast<const cn_msg*>(NLMSG_DATA(nlh));
+				if (msg->id.idx != CN_IDX_PROC or msg->id.val != CN_VAL_PROC) continue;
+				const auto* event = reinterpret_cast<const proc_event*>(msg->data);
+
+				switch (event->what) {
+					case proc_event::PROC_EVENT_FORK: {
+						const auto& fork = event->event_data.fork;
+						if (fork.child_pid == fork.child_tgid) pids.insert(fork.child_tgid);
+						break;
+					}
+					case proc_event::PROC_EVENT_EXEC:
+						pids.insert(event->event_data.exec.process_tgid);
+						break;
+					case proc_event::PROC_EVENT_EXIT: {
+						const auto& exit = event->event_data.exit;
+						if (exit.process_pid == exit.process_tgid) pids.erase(exit.process_tgid);
+						break;
+					}
+					case proc_event::PROC_EVENT_NONE:
+						//? Acknowledgement of the listen request, a listen without the needed privilege is refused here and not by send()
+						if (event->event_data.ack.err != 0) {
+							stop();
+							count = 0;
+							return false;
+						}
+						continue;
+					default:
+						continue;
+				}
+				count++;
+			}
+		}
+
+		const bool was_synced = synced;
+		synced = true;
+		return was_synced;
+	}
+
+	size_t last_count() noexcept {
+		return count;
+	}
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_set>
+
+//* Process fork/exec/exit notifications from the kernel proc connector (NETLINK_CONNECTOR)
+namespace ProcEvents {
+
+	//* Subscribe to process events, does nothing if already subscribed.
+	//* Returns false if the kernel lacks the proc connector. A process that is not allowed to listen (needs CAP_NET_ADMIN
+	//* in the initial user namespace) is only refused later, with an acknowledgement that poll() handles.
+	bool start();
+
+	//* Unsubscribe and close the netlink socket
+	void stop();
+
+	[[nodiscard]] bool active() noexcept;
+
+	//* Apply all queued events to <pids>, adding new processes and removing exited ones. Threads are ignored.
+	//* Returns false if events may have been missed, after start() or when the socket buffer overflowed,
+	//* in which case <pids> must be rebuilt from a full scan of /proc.
+	//* If the kernel refused the subscription the socket is closed and active() returns false.
+	bool poll(std::unordered_set<size_t>& pids);
+
+	//* Number of events applied by the last call to poll()
+	[[nodiscard]] size_t last_count() noexcept;
+}
@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "procfs.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+	#include <linux/io_uring.h>
+	#define HAS_IO_URING
+#endif
+
+namespace Procfs {
+
+	auto read_at(int dir_fd, const char* path, std::span<char> buffer) -> std::optional<std::string_view> {
+		const int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return std::nullopt;
+
+		ssize_t bytes;
+		do {
+			bytes = ::read(fd, buffer.data(), buffer.size());
+		} while (bytes < 0 and errno == EINTR);
+		close(fd);
+
+		if (bytes < 0) return std::nullopt;
+		return std::string_view { buffer.data(), static_cast<size_t>(bytes) };
+	}
+
+	auto parse_pid_stat(std::string_view stat) -> std::optional<pid_stat> {
+		const auto name_end = stat.rfind(')');
+		if (name_end == std::string_view::npos) return std::nullopt;
+
+		//? Fields are numbered as in proc(5), the state is field 3 directly after the name
+		Scanner scan { stat.substr(name_end + 1) };
+		pid_stat out;
+
+		const auto state = scan.field();
+		if (state.empty()) return std::nullopt;
+		out.state = state.front();
+
+		if (not scan.next(out.ppid)) return std::nullopt;
+		scan.skip(9);
+		if (not scan.next(out.utime) or not scan.next(out.stime)) return std::nullopt;
+		scan.skip(3);
+		if (not scan.next(out.nice) or not scan.next(out.threads)) return std::nullopt;
+		scan.skip(1);
+		if (not scan.next(out.starttime)) return std::nullopt;
+		scan.skip(1);
+		if (not scan.next(out.rss)) return std::nullopt;
+
+		return out;
+	}
+
+	auto parse_status_uid(std::string_view status) -> std::optional<uid_t> {
+		for (Scanner scan { status }; not scan.empty(); scan.next_line()) {
+			if (scan.rest().starts_with("Uid:")) {
+				scan.skip(1);
+				uid_t uid;
+				if (not scan.next(uid)) return std::nullopt;
+				return uid;
+			}
+		}
+		return std::nullopt;
+	}
+
+	auto parse_cpu_stat(Scanner& scan) -> std::optional<cpu_stat> {
+		Scanner line = scan;
+		const auto name = line.field();
+		if (not name.starts_with("cpu")) return std::nullopt;
+
+		cpu_stat out;
+		if (name.size() > 3) {
+			const auto [ptr, ec] = std::from_chars(name.data() + 3, name.data() + name.size(), out.core);
+			if (ec != std::errc{} or ptr != name.data() + name.size() or out.core < 0) return std::nullopt;
+		}
+
+		//? Fields added by future kernels are ignored
+		for (uint64_t value; out.count < cpu_stat::field_count and line.next(value); out.count++) {
+			out.times[out.count] = value;
+		}
+		if (out.count <= cpu_stat::idle) return std::nullopt;
+
+		line.next_line();
+		scan = line;
+		return out;
+	}
+
+	auto parse_meminfo(std::string_view meminfo) -> meminfo_stat {
+		constexpr uint32_t all_found = (1u << meminfo_stat::field_count) - 1;
+		meminfo_stat out;
+		for (Scanner scan { meminfo }; not scan.empty() and out.found != all_found; scan.next_line()) {
+			auto label = scan.field();
+			if (not label.ends_with(':')) continue;
+			label.remove_suffix(1);
+
+			const auto field = meminfo_field(label);
+			if (field == meminfo_stat::field_count) continue;
+
+			uint64_t value;
+			if (not scan.next(value)) continue;
+			if (scan.field() == "kB") value <<= 10;
+			out.values[field] = value;
+			out.found |= 1u << field;
+		}
+		return out;
+	}
+
+	auto parse_disk_stat(Scanner& scan) -> std::optional<disk_stat> {
+		Scanner line = scan;
+		disk_stat out;
+		for (auto& value : out.values) {
+			if (not line.next(value)) return std::nullopt;
+		}
+		line.next_line();
+		scan = line;
+		return out;
+	}
+
+	bool DiskStats::read(int dir_fd) {
+		//? The whole table has to fit in one read, the buffer grows until the read doesn't fill it
+		for (;;) {
+			const auto table = read_at(dir_fd, "diskstats", buf);
+			if (not table.has_value()) return false;
+			if (table->size() < buf.size()) {
+				parse(*table);
+				return true;
+			}
+			buf.resize(buf.size() * 2);
+		}
+	}
+
+	void DiskStats::parse(std::string_view table) {
+		devices.clear();
+		for (Scanner scan { table }; not scan.empty(); scan.next_line()) {
+			scan.skip(2);
+			const auto name = scan.field();
+			const auto rest = scan.rest();
+			if (not name.empty()) devices.push_back({ name, rest.substr(0, rest.find('\n')) });
+		}
+	}
+
+	auto DiskStats::find(std::string_view name, size_t& hint) const -> std::optional<disk_stat> {
+		if (hint >= devices.size() or devices[hint].name != name) {
+			const auto it = std::ranges::find(devices, name, &device::name);
+			if (it == devices.end()) return std::nullopt;
+			hint = it - devices.begin();
+		}
+		Scanner scan { devices[hint].counters };
+		return parse_disk_stat(scan);
+	}
+
+	namespace {
+		//? Decode the octal escapes the kernel uses for space, tab, newline and backslash in paths
+		auto decode_mount_path(std::string_view path) -> std::string {
+			std::string out;
+			out.reserve(path.size());
+			for (size_t i = 0; i < path.size(); i++) {
+				if (path[i] == '\\' and i + 3 < path.size()
+				and path[i + 1] >= '0' and path[i + 1] <= '3'
+				and path[i + 2] >= '0' and path[i + 2] <= '7'
+				and path[i + 3] >= '0' and path[i + 3] <= '7') {
+					out += static_cast<char>((path[i + 1] - '0') * 64 + (path[i + 2] - '0') * 8 + (path[i + 3] - '0'));
+					i += 3;
+				}
+				else out += path[i];
+			}
+			return out;
+		}
+	}
+
+	auto parse_mounts(std::string_view table) -> std::vector<mount_entry> {
+		std::vector<mount_entry> out;
+		for (Scanner scan { table }; not scan.empty(); scan.next_line()) {
+			const auto dev = scan.field();
+			const auto mountpoint = scan.field();
+			const auto fstype = scan.field();
+			if (fstype.empty()) continue;
+			out.push_back({ std::string(dev), decode_mount_path(mountpoint), std::string(fstype) });
+		}
+		return out;
+	}
+
+	MountTable::~MountTable() {
+		if (fd >= 0) close(fd);
+	}
+
+	bool MountTable::open(const std::string& path, bool watch) {
+		if (fd >= 0) close(fd);
+		fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		this->watch = watch;
+		stale = true;
+		return fd >= 0;
+	}
+
+	bool MountTable::update() {
+		if (fd < 0) throw std::runtime_error("Mount table is not open");
+		if (watch and not stale) {
+			pollfd pfd { fd, POLLPRI, 0 };
+			if (poll(&pfd, 1, 0) <= 0 or (pfd.revents & (POLLPRI | POLLERR)) == 0) return false;
+		}
+
+		//? The table is generated on read and returned in page sized chunks, read until end of file
+		buf.clear();
+		if (lseek(fd, 0, SEEK_SET) < 0) throw std::runtime_error(std::string("Failed to read mount table: ") + strerror(errno));
+		for (;;) {
+			const size_t size = buf.size();
+			buf.resize(size + 16384);
+			const auto bytes = ::read(fd, buf.data() + size, 16384);
+			if (bytes < 0 and errno == EINTR) {
+				buf.resize(size);
+				continue;
+			}
+			if (bytes < 0) throw std::runtime_error(std::string("Failed to read mount table: ") + strerror(errno));
+			buf.resize(size + bytes);
+			if (bytes == 0) break;
+		}
+		entries = parse_mounts(buf);
+		stale = false;
+		return true;
+	}
+
+#ifdef HAS_IO_URING
+	namespace {
+		inline unsigned load_acquire(unsigned* ptr) {
+			return std::atomic_ref<unsigned>(*ptr).load(std::memory_order_acquire);
+		}
+
+		inline void store_release(unsigned* ptr, unsigned value) {
+			std::atomic_ref<unsigned>(*ptr).store(value, std::memory_order_release);
+		}
+
+		template <typename T>
+		inline T* at_offset(void* base, unsigned offset) {
+			return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+		}
+
+		//? Kernels 5.1 to 5.5 set up rings but complete openat, read and close with -EINVAL, and also lack IORING_REGISTER_PROBE
+		bool ops_supported(int ring_fd) {
+			constexpr std::array ops { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE };
+			constexpr unsigned probe_ops = 256;
+			std::vector<char> buf(sizeof(io_uring_probe) + probe_ops * sizeof(io_uring_probe_op));
+			auto* probe = reinterpret_cast<io_uring_probe*>(buf.data());
+			if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, probe_ops) < 0) return false;
+			return std::ranges::all_of(ops, [&](auto op) {
+				return op <= probe->last_op and op < probe->ops_len and (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+			});
+		}
+	}
+
+	UringReader::~UringReader() {
+		release();
+	}
+
+	void UringReader::release() {
+		if (sqes != nullptr) munmap(sqes, sqes_size);
+		if (cq_ring != nullptr and cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+		if (sq_ring != nullptr) munmap(sq_ring, sq_ring_size);
+		if (ring_fd >= 0) close(ring_fd);
+		sqes = cq_ring = sq_ring = nullptr;
+		ring_fd = -1;
+	}
+
+	bool UringReader::init(unsigned size) {
+		if (ring_fd >= 0) return true;
+
+		io_uring_params params{};
+		ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, size, &params));
+		if (ring_fd < 0) return false;
+		if (not ops_supported(ring_fd)) {
+			release();
+			return false;
+		}
+		entries = params.sq_entries;
+
+		sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (single_mmap) sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+		sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+		if (sq_ring == MAP_FAILED) {
+			sq_ring = nullptr;
+			release();
+			return false;
+		}
+		cq_ring = single_mmap ? sq_ring : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (cq_ring == MAP_FAILED) {
+			cq_ring = nullptr;
+			release();
+			return false;
+		}
+		sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED) {
+			sqes = nullptr;
+			release();
+			return false;
+		}
+
+		sq_head = at_offset<unsigned>(sq_ring, params.sq_off.head);
+		sq_tail = at_offset<unsigned>(sq_ring, params.sq_off.tail);
+		sq_mask = at_offset<unsigned>(sq_ring, params.sq_off.ring_mask);
+		sq_array = at_offset<unsigned>(sq_ring, params.sq_off.array);
+		cq_head = at_offset<unsigned>(cq_ring, params.cq_off.head);
+		cq_tail = at_offset<unsigned>(cq_ring, params.cq_off.tail);
+		cq_mask = at_offset<unsigned>(cq_ring, params.cq_off.ring_mask);
+		cqes = at_offset<void>(cq_ring, params.cq_off.cqes);
+		return true;
+	}
+
+	template <typename F>
+	bool UringReader::submit_and_wait(unsigned count, F&& on_complete) {
+		unsigned submitted = 0, completed = 0;
+		bool failed = false;
+		auto reap = [&] {
+			auto* cqe_array = static_cast<io_uring_cqe*>(cqes);
+			unsigned head = *cq_head;
+			const unsigned tail = load_acquire(cq_tail);
+			for (; head != tail; head++, completed++) {
+				const auto& cqe = cqe_array[head & *cq_mask];
+				on_complete(cqe.user_data, cqe.res);
+			}
+			store_release(cq_head, head);
+		};
+
+		//? If submitting fails part way, still wait for the entries the kernel already took, so opened files are seen and can be closed
+		while (completed < (failed ? submitted : count)) {
+			const unsigned to_submit = failed ? 0 : count - submitted;
+			const unsigned to_wait = (failed ? submitted : count) - completed;
+			const long ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, to_wait, IORING_ENTER_GETEVENTS, nullptr, 0);
+			if (ret < 0) {
+				if (errno == EINTR or errno == EAGAIN or errno == EBUSY) continue;
+				if (failed) break;
+				failed = true;
+				continue;
+			}
+			submitted += ret;
+			reap();
+		}
+		if (failed) reap();
+		return not failed;
+	}
+
+	bool UringReader::read(int dir_fd, std::span<batch_read> reads) {
+		if (ring_fd < 0) return false;
+		auto* sqe_array = static_cast<io_uring_sqe*>(sqes);
+
+		//? Queue one operation for every file in <batch> where <include>(fd) is true, returns the number of queued operations
+		auto queue = [&](std::span<batch_read> batch, auto&& include, auto&& fill) -> unsigned {
+			unsigned tail = *sq_tail, count = 0;
+			for (size_t i = 0; i < batch.size(); i++) {
+				if (not include(fds[i])) continue;
+				const unsigned index = tail & *sq_mask;
+				auto& sqe = sqe_array[index];
+				std::memset(&sqe, 0, sizeof(sqe));
+				fill(sqe, i);
+				sqe.user_data = i;
+				sq_array[index] = index;
+				tail++;
+				count++;
+			}
+			store_release(sq_tail, tail);
+			return count;
+		};
+		const auto any = [](int) { return true; };
+		const auto opened = [](int fd) { return fd >= 0; };
+
+		for (size_t offset = 0; offset < reads.size(); offset += entries) {
+			auto batch = reads.subspan(offset, std::min<size_t>(entries, reads.size() - offset));
+			fds.assign(batch.size(), -1);
+
+			const unsigned open_count = queue(batch, any, [&](io_uring_sqe& sqe, size_t i) {
+				sqe.opcode = IORING_OP_OPENAT;
+				sqe.fd = dir_fd;
+				sqe.addr = reinterpret_cast<uint64_t>(batch[i].path);
+				sqe.open_flags = O_RDONLY | O_CLOEXEC;
+			});
+			bool ok = submit_and_wait(open_count, [&](uint64_t i, int res) {
+				fds[i] = res;
+				batch[i].result = res < 0 ? res : 0;
+			});
+
+			if (ok) {
+				const unsigned read_count = queue(batch, opened, [&](io_uring_sqe& sqe, size_t i) {
+					sqe.opcode = IORING_OP_READ;
+					sqe.fd = fds[i];
+					sqe.addr = reinterpret_cast<uint64_t>(batch[i].buffer.data());
+					sqe.len = static_cast<unsigned>(batch[i].buffer.size());
+					sqe.off = 0;
+				});
+				ok = submit_and_wait(read_count, [&](uint64_t i, int res) { batch[i].result = res; });
+			}
+
+			//? Close every opened file, files the ring didn't close are closed with plain close() before the ring is released
+			const auto fail = [&] {
+				for (const int fd : fds) if (fd >= 0) close(fd);
+				release();
+				return false;
+			};
+			if (not ok) return fail();
+
+			const unsigned close_count = queue(batch, opened, [&](io_uring_sqe& sqe, size_t i) {
+				sqe.opcode = IORING_OP_CLOSE;
+				sqe.fd = fds[i];
+			});
+			if (not submit_and_wait(close_count, [&](uint64_t i, int) { fds[i] = -1; })) return fail();
+		}
+		return true;
+	}
+#else
+	UringReader::~UringReader() {}
+	void UringReader::release() {}
+	bool UringReader::init(unsigned) { return false; }
+	bool UringReader::read(int, std::span<batch_read>) { return false; }
+#endif
+}
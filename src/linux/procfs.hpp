@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/types.h>
+
+//* Low overhead readers and parsers for files in /proc
+namespace Procfs {
+
+	//* Minimal forward scanner over whitespace separated fields in a buffer
+	class Scanner {
+		std::string_view buf;
+
+	public:
+		explicit constexpr Scanner(std::string_view buf) noexcept : buf(buf) {}
+
+		[[nodiscard]] constexpr bool empty() const noexcept { return buf.empty(); }
+
+		[[nodiscard]] constexpr auto rest() const noexcept -> std::string_view { return buf; }
+
+		//* Skip spaces and tabs, but not newlines
+		constexpr void skip_space() noexcept {
+			size_t i = 0;
+			while (i < buf.size() and (buf[i] == ' ' or buf[i] == '\t')) ++i;
+			buf.remove_prefix(i);
+		}
+
+		//* Return the next field on the current line, empty if at end of line
+		constexpr auto field() noexcept -> std::string_view {
+			skip_space();
+			size_t i = 0;
+			while (i < buf.size() and buf[i] != ' ' and buf[i] != '\t' and buf[i] != '\n') ++i;
+			const auto out = buf.substr(0, i);
+			buf.remove_prefix(i);
+			return out;
+		}
+
+		//* Skip <count> fields on the current line
+		constexpr void skip(size_t count) noexcept {
+			while (count-- > 0 and not field().empty());
+		}
+
+		//* Parse the next field as an integer, returns false and leaves <value> untouched on failure
+		template <std::integral T>
+		bool next(T& value) noexcept {
+			const auto str = field();
+			if (str.empty()) return false;
+			T parsed{};
+			const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), parsed);
+			if (ec != std::errc{} or ptr != str.data() + str.size()) return false;
+			value = parsed;
+			return true;
+		}
+
+		//* Advance past the next newline
+		constexpr void next_line() noexcept {
+			const auto pos = buf.find('\n');
+			buf.remove_prefix(pos == std::string_view::npos ? buf.size() : pos + 1);
+		}
+	};
+
+	//* Read the file <path> relative to the directory descriptor <dir_fd> into <buffer> with a single open/read/close.
+	//* Files in /proc and /sys return their whole contents in one read, so a short read is treated as end of file.
+	//* Returns a view into <buffer> or std::nullopt if the file could not be opened or read.
+	auto read_at(int dir_fd, const char* path, std::span<char> buffer) -> std::optional<std::string_view>;
+
+	//* Fields from /proc/[pid]/stat used by the process collector
+	struct pid_stat {
+		char state{};
+		uint64_t ppid{};
+		uint64_t utime{};
+		uint64_t stime{};
+		int64_t nice{};
+		uint64_t threads{};
+		uint64_t starttime{};
+		uint64_t rss{};
+	};
+
+	//* Parse the contents of /proc/[pid]/stat, returns std::nullopt if malformed or truncated.
+	//* The name is skipped by searching for the last ')' so names containing spaces or parentheses are handled.
+	auto parse_pid_stat(std::string_view stat) -> std::optional<pid_stat>;
+
+	//* Return the real uid from the "Uid:" line of /proc/[pid]/status, std::nullopt if not found
+	auto parse_status_uid(std::string_view status) -> std::optional<uid_t>;
+
+	//* Times from one "cpu" line of /proc/stat in USER_HZ ticks
+	struct cpu_stat {
+		//? Fields in the order of proc(5), only the first <count> are valid
+		enum field : uint8_t { user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice, field_count };
+
+		int core = -1; //? -1 for the aggregate "cpu" line
+		uint8_t count{};
+		std::array<uint64_t, field_count> times{};
+
+		//* Sum of all fields except guest and guest_nice, which are already included in user and nice
+		[[nodiscard]] constexpr auto total() const noexcept -> uint64_t {
+			uint64_t sum = 0;
+			for (uint8_t i = 0; i < count and i < guest; i++) sum += times[i];
+			return sum;
+		}
+
+		//* Idle time including iowait
+		[[nodiscard]] constexpr auto idle_total() const noexcept -> uint64_t {
+			return times[idle] + times[iowait];
+		}
+	};
+
+	//* Parse the "cpu" line at the position of <scan> and advance to the next line.
+	//* Returns std::nullopt without advancing if the line is not a "cpu" line or has fewer than four fields.
+	auto parse_cpu_stat(Scanner& scan) -> std::optional<cpu_stat>;
+
+	//* Fields from /proc/meminfo used by the memory collector, sizes are in bytes and the HugePages_ fields are page counts
+	struct meminfo_stat {
+		enum field : uint8_t {
+			mem_total, mem_free, mem_available, cached, swap_total, swap_free,
+			dirty, writeback, shmem, slab, committed_as, hugepages_total, hugepages_free, hugepage_size, field_count
+		};
+
+		std::array<uint64_t, field_count> values{};
+		uint32_t found{}; //? Bit for each field that was present
+
+		[[nodiscard]] constexpr bool has(field f) const noexcept { return found & (1u << f); }
+		[[nodiscard]] constexpr auto operator[](field f) const noexcept -> uint64_t { return values[f]; }
+	};
+
+	//* The field for a /proc/meminfo label without its colon, field_count if the label isn't parsed.
+	//* Labels are matched on length first so most lines cost a single comparison.
+	constexpr auto meminfo_field(std::string_view label) noexcept -> meminfo_stat::field {
+		using enum meminfo_stat::field;
+		switch (label.size()) {
+			case 4: if (label == "Slab") return slab; break;
+			case 5:
+				if (label == "Dirty") return dirty;
+				if (label == "Shmem") return shmem;
+				break;
+			case 6: if (label == "Cached") return cached; break;
+			case 7: if (label == "MemFree") return mem_free; break;
+			case 8:
+				if (label == "MemTotal") return mem_total;
+				if (label == "SwapFree") return swap_free;
+				break;
+			case 9:
+				if (label == "SwapTotal") return swap_total;
+				if (label == "Writeback") return writeback;
+				break;
+			case 12:
+				if (label == "MemAvailable") return mem_available;
+				if (label == "Committed_AS") return committed_as;
+				if (label == "Hugepagesize") return hugepage_size;
+				break;
+			case 14: if (label == "HugePages_Free") return hugepages_free; break;
+			case 15: if (label == "HugePages_Total") return hugepages_total; break;
+			default: break;
+		}
+		return field_count;
+	}
+
+	//* Parse the contents of /proc/meminfo, unknown labels and malformed lines are skipped.
+	//* Stops at the first line after all fields were found.
+	auto parse_meminfo(std::string_view meminfo) -> meminfo_stat;
+
+	//* I/O counters of a block device, in the order of /proc/diskstats and /sys/block/<dev>/stat, times are in milliseconds
+	struct disk_stat {
+		enum field : uint8_t {
+			reads, reads_merged, sectors_read, read_ms, writes, writes_merged, sectors_written, write_ms,
+			in_flight, io_ms, queue_ms, field_count
+		};
+
+		std::array<uint64_t, field_count> values{};
+	};
+
+	//* Parse the counters at the position of <scan> and advance to the next line.
+	//* Discard and flush counters of newer kernels are ignored, returns std::nullopt if a counter is missing.
+	auto parse_disk_stat(Scanner& scan) -> std::optional<disk_stat>;
+
+	//* All block devices from /proc/diskstats, read with a single read into a buffer reused between reads.
+	//* Only the device names are indexed, counters are parsed when a device is looked up.
+	class DiskStats {
+		struct device {
+			std::string_view name;
+			std::string_view counters;
+		};
+		std::vector<char> buf = std::vector<char>(16384);
+		std::vector<device> devices;
+
+	public:
+		//* Read "diskstats" relative to <dir_fd>, returns false if it can't be read
+		bool read(int dir_fd);
+
+		//* Index a table in the format of /proc/diskstats, <table> must outlive the next parse
+		void parse(std::string_view table);
+
+		//* Counters of the device named <name>, std::nullopt if there is no such device or its line is malformed.
+		//* <hint> is the index of the last match and makes lookups in an unchanged table O(1).
+		auto find(std::string_view name, size_t& hint) const -> std::optional<disk_stat>;
+
+		[[nodiscard]] auto size() const noexcept -> size_t { return devices.size(); }
+	};
+
+	//* Device, mountpoint and filesystem type from one line of /proc/self/mounts, octal escapes like \040 are decoded
+	struct mount_entry {
+		std::string dev;
+		std::string mountpoint;
+		std::string fstype;
+	};
+
+	//* Parse a mount table in the format of /proc/self/mounts and /etc/mtab, lines with fewer than three fields are skipped
+	auto parse_mounts(std::string_view table) -> std::vector<mount_entry>;
+
+	//* Cached mount table that is only read again when it changed.
+	//* The kernel reports changes to the mounts of the namespace as POLLPRI on an open /proc/self/mounts, so a check is a single poll() call.
+	class MountTable {
+		int fd = -1;
+		bool watch{};
+		bool stale = true;
+		std::string buf;
+		std::vector<mount_entry> entries;
+
+	public:
+		MountTable() = default;
+		~MountTable();
+		MountTable(const MountTable& other) = delete;
+		MountTable& operator=(const MountTable& other) = delete;
+
+		//* Open <path>, with <watch> set the file is polled for changes, otherwise it's read again on every update()
+		bool open(const std::string& path, bool watch);
+		[[nodiscard]] bool is_open() const noexcept { return fd >= 0; }
+
+		//* Read the table if it changed since the last read, returns true if it was read.
+		//* Throws std::runtime_error if the file can't be read.
+		bool update();
+
+		[[nodiscard]] auto mounts() const noexcept -> const std::vector<mount_entry>& { return entries; }
+	};
+
+	//* A file to read with UringReader, <result> is set to the number of bytes read or a negative errno value
+	struct batch_read {
+		const char* path;
+		std::span<char> buffer;
+		int result{};
+	};
+
+	//* Reads many small files with io_uring, using three io_uring_enter calls (open, read, close) per batch instead of three syscalls per file.
+	//* Uses the raw system calls so no liburing dependency is needed.
+	class UringReader {
+		int ring_fd = -1;
+		void* sq_ring{};
+		void* cq_ring{};
+		void* sqes{};
+		size_t sq_ring_size{};
+		size_t cq_ring_size{};
+		size_t sqes_size{};
+		unsigned entries{};
+
+		unsigned *sq_head{}, *sq_tail{}, *sq_mask{}, *sq_array{};
+		unsigned *cq_head{}, *cq_tail{}, *cq_mask{};
+		void* cqes{};
+		std::vector<int> fds;
+
+		//? Submit the queued entries and wait for all of their completions, <on_complete> is called with (user_data, result)
+		template <typename F>
+		bool submit_and_wait(unsigned count, F&& on_complete);
+		void release();
+	public:
+		UringReader() = default;
+		~UringReader();
+		UringReader(const UringReader& other) = delete;
+		UringReader& operator=(const UringReader& other) = delete;
+		UringReader(UringReader&& other) = delete;
+		UringReader& operator=(UringReader&& other) = delete;
+
+		//* Set up a ring with room for <size> files per batch, returns false if io_uring is unsupported or disabled,
+		//* or the kernel lacks the openat, read or close operations
+		bool init(unsigned size);
+		[[nodiscard]] bool ready() const noexcept { return ring_fd >= 0; }
+
+		//* Open, read and close every file in <reads> relative to <dir_fd>.
+		//* Returns false if the ring failed, the reader is then closed and results must not be used.
+		bool read(int dir_fd, std::span<batch_read> reads);
+	};
+}
@@ -592,57 +592,59 @@ namespace Mem {
 		auto &mem = current_mem;
 		static bool snapped = (getenv("BTOP_SNAPPED") != nullptr);
 
-		u_int memActive, memWire, cachedMem;
-		// u_int freeMem;
-		size_t size;
-		static int uvmexp_mib[] = {CTL_VM, VM_UVMEXP};
-		static int bcstats_mib[] = {CTL_VFS, VFS_GENERIC, VFS_BCACHESTAT};
-		struct uvmexp uvmexp;
-		struct bcachestats bcstats;
-		size = sizeof(uvmexp);
-		if (sysctl(uvmexp_mib, 2, &uvmexp, &size, NULL, 0) == -1) {
-			Logger::error("sysctl failed");
-			bzero(&uvmexp, sizeof(uvmexp));
-		}
-		size = sizeof(bcstats);
-		if (sysctl(bcstats_mib, 3, &bcstats, &size, NULL, 0) == -1) {
-			Logger::error("sysctl failed");
-			bzero(&bcstats, sizeof(bcstats));
-		}
-		memActive = uvmexp.active * Shared::pageSize;
-		memWire = uvmexp.wired;
-		// freeMem = uvmexp.free * Shared::pageSize;
-		cachedMem = bcstats.numbufpages * Shared::pageSize;
-		mem.stats.at("used") = memActive;
-		mem.stats.at("available") = Shared::totalMem - memActive - memWire;
-   		mem.stats.at("cached") = cachedMem;
-  		mem.stats.at("free") = Shared::totalMem - memActive - memWire;
-
-		if (show_swap) {
-			int total = uvmexp.swpages * Shared::pageSize;
-			mem.stats.at("swap_total") = total;
-			int swapped = uvmexp.swpgonly * Shared::pageSize;
-			mem.stats.at("swap_used") = swapped;
-			mem.stats.at("swap_free") = total - swapped;
-		}
+		if (collect_mem) {
+			u_int memActive, memWire, cachedMem;
+			// u_int freeMem;
+			size_t size;
+			static int uvmexp_mib[] = {CTL_VM, VM_UVMEXP};
+			static int bcstats_mib[] = {CTL_VFS, VFS_GENERIC, VFS_BCACHESTAT};
+			struct uvmexp uvmexp;
+			struct bcachestats bcstats;
+			size = sizeof(uvmexp);
+			if (sysctl(uvmexp_mib, 2, &uvmexp, &size, NULL, 0) == -1) {
+				Logger::error("sysctl failed");
+				bzero(&uvmexp, sizeof(uvmexp));
+			}
+			size = sizeof(bcstats);
+			if (sysctl(bcstats_mib, 3, &bcstats, &size, NULL, 0) == -1) {
+				Logger::error("sysctl failed");
+				bzero(&bcstats, sizeof(bcstats));
+			}
+			memActive = uvmexp.active * Shared::pageSize;
+			memWire = uvmexp.wired;
+			// freeMem = uvmexp.free * Shared::pageSize;
+			cachedMem = bcstats.numbufpages * Shared::pageSize;
+			mem.stats.at("used") = memActive;
+			mem.stats.at("available") = Shared::totalMem - memActive - memWire;
+	   		mem.stats.at("cached") = cachedMem;
+	  		mem.stats.at("free") = Shared::totalMem - memActive - memWire;
+
+			if (show_swap) {
+				int total = uvmexp.swpages * Shared::pageSize;
+				mem.stats.at("swap_total") = total;
+				int swapped = uvmexp.swpgonly * Shared::pageSize;
+				mem.stats.at("swap_used") = swapped;
+				mem.stats.at("swap_free") = total - swapped;
+			}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
-			for (const auto &name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
+			if (show_swap and mem.stats.at("swap_total") > 0) {
+				for (const auto &name : swap_names) {
+					mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
+					while (cmp_greater(mem.percent.at(name).size(), width * 2))
+						mem.percent.at(name).pop_front();
+				}
+				has_swap = true;
+			} else
+				has_swap = false;
+			//? Calculate percentages
+			for (const auto &name : mem_names) {
+				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / Shared::totalMem));
 				while (cmp_greater(mem.percent.at(name).size(), width * 2))
 					mem.percent.at(name).pop_front();
 			}
-			has_swap = true;
-		} else
-			has_swap = false;
-		//? Calculate percentages
-		for (const auto &name : mem_names) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / Shared::totalMem));
-			while (cmp_greater(mem.percent.at(name).size(), width * 2))
-				mem.percent.at(name).pop_front();
 		}
 
-		if (show_disks) {
+		if (show_disks and collect_disks) {
 			std::unordered_map<string, string> mapping;  // keep mapping from device -> mountpoint, since IOKit doesn't give us the mountpoint
 			double uptime = system_uptime();
 			auto &disks_filter = Config::getS("disks_filter");
@@ -982,6 +984,7 @@ namespace Net {
 namespace Proc {
 
 	vector<proc_info> current_procs;
+	vector<proc_row> proc_table;
 	std::unordered_map<string, string> uid_user;
 	string current_sort;
 	string current_filter;
@@ -1009,7 +1012,7 @@ namespace Proc {
 	}
 
 	//* Get detailed info for selected process
-	void _collect_details(const size_t pid, vector<proc_info> &procs) {
+	void _collect_details(const size_t pid, const long core_count, vector<proc_info> &procs) {
 		if (pid != detailed.last_pid) {
 			detailed = {};
 			detailed.last_pid = pid;
@@ -1021,7 +1024,7 @@ namespace Proc {
 		detailed.entry = *p_info;
 
 		//? Update cpu percent deque for process cpu graph
-		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
+		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= core_count;
 		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
 		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
 
@@ -1054,10 +1057,11 @@ namespace Proc {
 	}
 
 	//* Collects and sorts process information from /proc
-	auto collect(bool no_update) -> vector<proc_info> & {
+	auto collect(bool no_update, long core_count) -> vector<proc_info> & {
 		const auto &sorting = Config::getS("proc_sorting");
 		auto reverse = Config::getB("proc_reversed");
 		const auto &filter = Config::getS("proc_filter");
+		const auto& compiled_filter = get_compiled_filter(filter);
 		auto per_core = Config::getB("proc_per_core");
 		auto tree = Config::getB("proc_tree");
 		auto show_detailed = Config::getB("show_detailed");
@@ -1073,14 +1077,14 @@ namespace Proc {
 		}
 		if (tree_mode_change) is_tree_mode = tree;
 
-		const int cmult = (per_core) ? Shared::coreCount : 1;
+		const int cmult = (per_core) ? core_count : 1;
 		bool got_detailed = false;
 
 		static vector<size_t> found;
 
 		//* Use pids from last update if only changing filter, sorting or tree options
 		if (no_update and not current_procs.empty()) {
-			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, current_procs);
+			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, core_count, current_procs);
 		} else {
 			//* ---------------------------------------------Collection start----------------------------------------------
 
@@ -1153,7 +1157,7 @@ namespace Proc {
 				new_proc.threads = 1; // can't seem to find this in kinfo_proc
 
 				//? Process cpu usage since last update
-				new_proc.cpu_p = clamp((100.0 * kproc->p_pctcpu / Shared::kfscale) * cmult, 0.0, 100.0 * Shared::coreCount);
+				new_proc.cpu_p = clamp((100.0 * kproc->p_pctcpu / Shared::kfscale) * cmult, 0.0, 100.0 * core_count);
 
 				//? Process cumulative cpu usage since process start
 				new_proc.cpu_c = (double)(cpu_t * Shared::clkTck / 1'000'000) / max(1.0, timeNow - new_proc.cpu_s);
@@ -1195,7 +1199,7 @@ namespace Proc {
 
 			//? Update the details info box for process if active
 			if (show_detailed and got_detailed) {
-				_collect_details(detailed_pid, current_procs);
+				_collect_details(detailed_pid, core_count, current_procs);
 			} else if (show_detailed and not got_detailed and detailed.status != "Dead") {
 				detailed.status = "Dead";
 				redraw = true;
@@ -1207,12 +1211,16 @@ namespace Proc {
 
 		//* ---------------------------------------------Collection done-----------------------------------------------
 
+		//? The filter, sort and tree passes work on packed rows of the hot fields and read strings from current_procs through the row slots,
+		//? current_procs itself is only reordered once when the rows are applied
+		fill_table(proc_table, current_procs);
+
 		//* Match filter if defined
 		if (should_filter) {
 			filter_found = 0;
-			for (auto& p : current_procs) {
+			for (auto& p : proc_table) {
 				if (not tree and not filter.empty()) {
-					if (!matches_filter(p, filter)) {
+					if (!matches_filter(current_procs[p.slot], compiled_filter)) {
 						p.filtered = true;
 						filter_found++;
 					} else {
@@ -1226,7 +1234,7 @@ namespace Proc {
 
 		//* Sort processes
 		if ((sorted_change or tree_mode_change) or (not no_update and not pause_proc_list)) {
-			proc_sorter(current_procs, sorting, reverse, tree);
+			proc_sorter(proc_table, current_procs, sorting, reverse, tree);
 		}
 
 		//* Generate tree view if enabled
@@ -1234,12 +1242,12 @@ namespace Proc {
 			bool locate_selection = false;
 
 			if (toggle_children != -1) {
-				auto collapser = rng::find(current_procs, toggle_children, &proc_info::pid);
-				if (collapser != current_procs.end()){
-					for (auto& p : current_procs) {
+				auto collapser = rng::find(proc_table, toggle_children, &proc_row::pid);
+				if (collapser != proc_table.end()){
+					for (auto& p : proc_table) {
 						if (p.ppid == collapser->pid) {
-							auto child = rng::find(current_procs, p.pid, &proc_info::pid);
-							if (child != current_procs.end()){
+							auto child = rng::find(proc_table, p.pid, &proc_row::pid);
+							if (child != proc_table.end()){
 								child->collapsed = not child->collapsed;
 							}
 						}
@@ -1250,8 +1258,8 @@ namespace Proc {
 			}
 
 			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
-				auto collapser = rng::find(current_procs, find_pid, &proc_info::pid);
-				if (collapser != current_procs.end()) {
+				auto collapser = rng::find(proc_table, find_pid, &proc_row::pid);
+				if (collapser != proc_table.end()) {
 					if (collapse == expand) {
 						collapser->collapsed = not collapser->collapsed;
 					}
@@ -1267,7 +1275,7 @@ namespace Proc {
 			}
 
 			if (collapse_all != -1) {
-				toggle_tree_collapse(current_procs);
+				toggle_tree_collapse(proc_table);
 				collapse_all = -1;
 				if (Config::ints.at("proc_selected") > 0) locate_selection = true;
 			}
@@ -1275,46 +1283,48 @@ namespace Proc {
 			if (should_filter or not filter.empty()) filter_found = 0;
 
 			vector<tree_proc> tree_procs;
-			tree_procs.reserve(current_procs.size());
+			tree_procs.reserve(proc_table.size());
 
 			if (!pause_proc_list) {
-				for (auto& p : current_procs) {
+				for (auto& p : proc_table) {
 					if (not v_contains(found, p.ppid)) p.ppid = 0;
 				}
 			}
 
 			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(current_procs, rng::less{}, & proc_info::ppid);
+			rng::stable_sort(proc_table, rng::less{}, & proc_row::ppid);
 
 			//? Auto-collapse processes with many children when entering tree mode
-			_auto_collapse_oversized(current_procs, tree_mode_change);
+			_auto_collapse_oversized(proc_table, tree_mode_change);
 
 			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
+			for (auto& p : rng::equal_range(proc_table, proc_table.at(0).ppid, rng::less{}, &proc_row::ppid)) {
+				_tree_gen(p, proc_table, current_procs, tree_procs, 0, false, compiled_filter, false, no_update, should_filter);
 			}
 
 			//? Recursive sort over tree structure to account for collapsed processes in the tree
 			int index = 0;
-			tree_sort(tree_procs, sorting, reverse, (pause_proc_list and not (sorted_change or tree_mode_change)), index, current_procs.size());
+			tree_sort(tree_procs, sorting, reverse, (pause_proc_list and not (sorted_change or tree_mode_change)), index, proc_table.size());
 
 			//? Recursive construction of ASCII tree prefixes.
 			for (auto t = tree_procs.begin(); t != tree_procs.end(); ++t) {
-				_collect_prefixes(*t, t == tree_procs.end() - 1);
+				_collect_prefixes(*t, current_procs, t == tree_procs.end() - 1);
 			}
 
 			//? Final sort based on tree index
-			rng::stable_sort(current_procs, rng::less {}, &proc_info::tree_index);
+			rng::stable_sort(proc_table, rng::less {}, &proc_row::tree_index);
 
 			//? Move current selection/view to the selected process when collapsing/expanding in the tree
 			if (locate_selection) {
-				int loc = rng::find(current_procs, Proc::selected_pid, &proc_info::pid)->tree_index;
+				int loc = rng::find(proc_table, Proc::selected_pid, &proc_row::pid)->tree_index;
 				if (Config::ints.at("proc_start") >= loc or Config::ints.at("proc_start") <= loc - Proc::select_max)
 					Config::ints.at("proc_start") = max(0, loc - 1);
 				Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
 			}
 		}
 
+		apply_table(proc_table, current_procs);
+
 		numpids = (int)current_procs.size() - filter_found;
 		return current_procs;
 	}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "btop_draw.hpp"
+#include "btop_history.hpp"
+#include "btop_tools.hpp"
+
+using namespace std::literals;
+
+TEST(draw, graph_braille) {
+	const auto skip = Mv::r(1);
+	Tools::RingBuffer<long long> data { 100, 100 };
+	Draw::Graph graph { 3, 1, "", data, "braille" };
+	EXPECT_EQ(graph(), skip + skip + "⣿");
+
+	//? Every new value replaces the oldest column, the old value is paired with the new one in the same character
+	data.push_back(0);
+	EXPECT_EQ(graph(data), skip + "⢸⡇");
+	data.push_back(50);
+	EXPECT_EQ(graph(data), skip + "⣿⢠"s);
+	EXPECT_EQ(graph(data, true), skip + "⣿⢠"s);
+
+	for (int i = 0; i < 100; i++) {
+		data.push_back(100);
+		graph(data);
+	}
+	EXPECT_EQ(graph(), "⣿⣿⣿");
+}
+
+TEST(draw, graph_history_gap) {
+	//? Steps without samples in a zoomed out history are blank, even with no_zero set
+	constexpr auto gap = Tools::history_gap<long long>;
+	Tools::RingBuffer<long long> data { 100, gap, gap, 100 };
+	Draw::Graph graph { 2, 1, "", data, "braille", false, true, 0, 0, true };
+	EXPECT_EQ(graph(), "⡇⢸");
+
+	//? Live data can reach the gap value, e.g. a saturated uint8_t history, and is drawn as a full column
+	Tools::RingBuffer<uint8_t> live { 255, 255 };
+	Draw::Graph full { 1, 1, "", live, "braille" };
+	EXPECT_EQ(full(), "⣿");
+}
+
+TEST(draw, graph_multi_row) {
+	Tools::RingBuffer<long long> data { 0, 50, 100, 100 };
+	Draw::Graph graph { 2, 2, "", data, "braille" };
+	const auto line_break = Mv::d(1) + Mv::l(2);
+	EXPECT_EQ(graph(), " ⣿"s + line_break + "⢸⣿");
+
+	Draw::Graph inverted { 2, 2, "", data, "braille", true };
+	EXPECT_EQ(inverted(), "⢸⣿"s + line_break + " ⣿");
+
+	Draw::Graph empty { 0, 2, "", data, "braille" };
+	EXPECT_EQ(empty(data), "");
+}
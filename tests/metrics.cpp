@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_metrics.hpp"
+
+namespace {
+	void update(const Cpu::cpu_info* cpu, const std::unordered_map<std::string, Net::net_info>* nets, const std::vector<Proc::proc_info>* procs) {
+		Metrics::update(
+			cpu, nullptr, nets,
+		#ifdef GPU_SUPPORT
+			nullptr,
+		#endif
+			procs
+		);
+	}
+}
+
+TEST(metrics, snapshot) {
+	Cpu::cpu_info cpu;
+	cpu.cpu_percent.at("total").push_back(42);
+	cpu.core_percent = { {7} };
+	cpu.load_avg = { 1.5, 0.5, 0.25 };
+
+	std::unordered_map<std::string, Net::net_info> nets;
+	nets["eth\"0"].stat.at("download").speed = 100;
+
+	std::vector<Proc::proc_info> procs(Metrics::top_procs + 2);
+	for (size_t i = 0; i < procs.size(); i++) {
+		procs[i].pid = i + 1;
+		procs[i].cpu_p = static_cast<double>(i);
+		procs[i].name = "proc";
+		procs[i].user = "user";
+	}
+	procs.back().name = "a\\b\nc";
+
+	const auto before = Metrics::snapshot();
+	update(&cpu, &nets, &procs);
+	const auto after = Metrics::snapshot();
+	ASSERT_NE(before, after);
+
+	const std::string& text = *after;
+	EXPECT_TRUE(text.starts_with("# HELP btop_cpu_usage_percent "));
+	EXPECT_TRUE(text.contains("# TYPE btop_cpu_usage_percent gauge\nbtop_cpu_usage_percent{core=\"total\"} 42\nbtop_cpu_usage_percent{core=\"0\"} 7\n"));
+	EXPECT_TRUE(text.contains("btop_load_average{period=\"15m\"} 0.25\n"));
+	EXPECT_TRUE(text.contains("btop_network_bytes_per_second{iface=\"eth\\\"0\",direction=\"download\"} 100\n"));
+	EXPECT_TRUE(text.contains("# TYPE btop_network_bytes_total counter\n"));
+
+	//? Only the processes with the highest cpu usage are exported, highest first
+	EXPECT_TRUE(text.contains("btop_process_cpu_percent{pid=\"12\",name=\"a\\\\b\\nc\",user=\"user\"} 11.0\nbtop_process_cpu_percent{pid=\"11\","));
+	EXPECT_TRUE(text.contains("{pid=\"3\","));
+	EXPECT_FALSE(text.contains("{pid=\"2\","));
+
+	//? Boxes that weren't collected keep their last values, the old snapshot is left as it was
+	cpu.cpu_percent.at("total").push_back(43);
+	update(&cpu, nullptr, nullptr);
+	const auto next = Metrics::snapshot();
+	EXPECT_TRUE(next->contains("btop_cpu_usage_percent{core=\"total\"} 43\n"));
+	EXPECT_TRUE(next->contains("btop_network_bytes_per_second{iface="));
+	EXPECT_TRUE(next->contains("btop_process_cpu_percent{pid=\"12\","));
+	EXPECT_TRUE(after->contains("btop_cpu_usage_percent{core=\"total\"} 42\n"));
+}
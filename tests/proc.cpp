@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_shared.hpp"
+
+namespace {
+	auto make_proc() -> Proc::proc_info {
+		Proc::proc_info proc { .pid = 4217 };
+		proc.name = "Firefox";
+		proc.cmd = "/usr/lib/firefox/firefox -contentproc";
+		proc.user = "alice";
+		return proc;
+	}
+}
+
+TEST(proc, filter_plain) {
+	const auto proc = make_proc();
+	EXPECT_TRUE(Proc::CompiledFilter("").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("fire").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("FIREFOX").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("contentProc").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("Alice").matches(proc));
+	EXPECT_FALSE(Proc::CompiledFilter("chrome").matches(proc));
+	EXPECT_FALSE(Proc::CompiledFilter("firefox -contentproc --").matches(proc));
+}
+
+TEST(proc, filter_pid) {
+	const auto proc = make_proc();
+	EXPECT_TRUE(Proc::CompiledFilter("4217").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("21").matches(proc));
+	EXPECT_FALSE(Proc::CompiledFilter("4218").matches(proc));
+}
+
+TEST(proc, filter_regex) {
+	const auto proc = make_proc();
+	EXPECT_TRUE(Proc::CompiledFilter("!").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("!^Fire").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("!^42[0-9]+$").matches(proc));
+	EXPECT_FALSE(Proc::CompiledFilter("!^fire").matches(proc));
+	//? The command line has to match the whole expression
+	EXPECT_FALSE(Proc::CompiledFilter("!/usr/lib").matches(proc));
+	EXPECT_TRUE(Proc::CompiledFilter("!/usr/lib.*").matches(proc));
+	//? Incomplete expressions match nothing
+	EXPECT_FALSE(Proc::CompiledFilter("!fire(").matches(proc));
+}
+
+TEST(proc, compiled_filter_cache) {
+	const auto& first = Proc::get_compiled_filter("fire");
+	EXPECT_EQ(first.str(), "fire");
+	EXPECT_EQ(&Proc::get_compiled_filter("fire"), &first);
+	EXPECT_EQ(Proc::get_compiled_filter("!x").str(), "!x");
+}
+
+TEST(proc, sorter_matches_stable_sort) {
+	std::mt19937 rng { 1234 };
+	std::vector<Proc::proc_info> procs;
+	for (size_t pid = 1; pid <= 500; pid++) {
+		Proc::proc_info proc { .pid = pid };
+		proc.name = "proc" + std::to_string(rng() % 40);
+		proc.user = (rng() % 3 == 0) ? "root" : "alice";
+		proc.mem = rng() % 100;
+		proc.cpu_p = (rng() % 10) / 2.0;
+		procs.push_back(proc);
+	}
+
+	const auto pids = [](const std::vector<Proc::proc_info>& vec) {
+		std::vector<size_t> out;
+		for (const auto& p : vec) out.push_back(p.pid);
+		return out;
+	};
+
+	auto sort_by = [](std::vector<Proc::proc_info>& vec, const std::string& sorting, bool reverse) {
+		//? Numeric keys sort descending and strings ascending unless reversed
+		if (sorting == "name") {
+			if (reverse) std::ranges::stable_sort(vec, std::ranges::greater{}, &Proc::proc_info::name);
+			else std::ranges::stable_sort(vec, std::ranges::less{}, &Proc::proc_info::name);
+		}
+		else if (sorting == "user") {
+			if (reverse) std::ranges::stable_sort(vec, std::ranges::greater{}, &Proc::proc_info::user);
+			else std::ranges::stable_sort(vec, std::ranges::less{}, &Proc::proc_info::user);
+		}
+		else if (sorting == "memory") {
+			if (reverse) std::ranges::stable_sort(vec, std::ranges::less{}, &Proc::proc_info::mem);
+			else std::ranges::stable_sort(vec, std::ranges::greater{}, &Proc::proc_info::mem);
+		}
+		else {
+			if (reverse) std::ranges::stable_sort(vec, std::ranges::less{}, &Proc::proc_info::cpu_p);
+			else std::ranges::stable_sort(vec, std::ranges::greater{}, &Proc::proc_info::cpu_p);
+		}
+	};
+
+	for (const bool reverse : { false, true }) {
+		for (const std::string sorting : { "name", "user", "memory", "cpu direct" }) {
+			auto expected = procs;
+			auto actual = procs;
+			//? Change a few values after the first sort so the second sort starts from a nearly sorted order
+			for (int pass = 0; pass < 2; pass++) {
+				sort_by(expected, sorting, reverse);
+				Proc::proc_sorter(actual, sorting, reverse);
+				EXPECT_EQ(pids(actual), pids(expected)) << sorting << (reverse ? " reversed" : "");
+
+				for (size_t i = 0; i < expected.size(); i += 37) {
+					expected[i].mem = actual[i].mem = rng() % 100;
+					expected[i].cpu_p = actual[i].cpu_p = (rng() % 10) / 2.0;
+				}
+			}
+		}
+	}
+}
+
+TEST(proc, table_tree) {
+	std::vector<Proc::proc_info> procs;
+	for (const auto& [pid, ppid] : { std::pair<size_t, uint64_t>{ 4, 2 }, { 1, 0 }, { 2, 1 }, { 3, 1 } }) {
+		Proc::proc_info proc { .pid = pid, .ppid = ppid };
+		proc.name = "proc" + std::to_string(pid);
+		proc.cmd = "/bin/proc" + std::to_string(pid);
+		procs.push_back(proc);
+	}
+
+	//? Same passes as the collectors run in tree mode
+	std::vector<Proc::proc_row> table;
+	Proc::fill_table(table, procs);
+	Proc::proc_sorter(table, procs, "pid", false, true);
+	std::ranges::stable_sort(table, std::ranges::less{}, &Proc::proc_row::ppid);
+	std::vector<Proc::tree_proc> tree_procs;
+	for (auto& p : std::ranges::equal_range(table, table.at(0).ppid, std::ranges::less{}, &Proc::proc_row::ppid)) {
+		Proc::_tree_gen(p, table, procs, tree_procs, 0, false, Proc::CompiledFilter(""));
+	}
+	int index = 0;
+	Proc::tree_sort(tree_procs, "pid", false, false, index, table.size());
+	for (auto t = tree_procs.begin(); t != tree_procs.end(); ++t) {
+		Proc::_collect_prefixes(*t, procs, t == tree_procs.end() - 1);
+	}
+	std::ranges::stable_sort(table, std::ranges::less{}, &Proc::proc_row::tree_index);
+	Proc::apply_table(table, procs);
+
+	//? Siblings keep the descending pid order and every string moved along with its process
+	const std::vector<size_t> expected_pids { 1, 3, 2, 4 };
+	const std::vector<size_t> expected_depths { 0, 1, 1, 2 };
+	const std::vector<std::string> expected_prefixes { "[-]─", "    ├─", "   [-]─", "       └─" };
+	for (size_t i = 0; i < procs.size(); i++) {
+		EXPECT_EQ(procs[i].pid, expected_pids[i]);
+		EXPECT_EQ(procs[i].depth, expected_depths[i]);
+		EXPECT_EQ(procs[i].prefix, expected_prefixes[i]);
+		EXPECT_EQ(procs[i].name, "proc" + std::to_string(procs[i].pid));
+		EXPECT_EQ(procs[i].short_cmd, "proc" + std::to_string(procs[i].pid));
+		EXPECT_EQ(table[i].slot, i);
+	}
+}
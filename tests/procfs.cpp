@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "linux/procfs.hpp"
+
+using namespace std::literals;
+
+TEST(procfs, scanner) {
+	Procfs::Scanner scan { "cpu  10 20\t30\nintr 5\n"sv };
+	EXPECT_EQ(scan.field(), "cpu"sv);
+	uint64_t value{};
+	EXPECT_TRUE(scan.next(value));
+	EXPECT_EQ(value, 10);
+	scan.skip(1);
+	EXPECT_TRUE(scan.next(value));
+	EXPECT_EQ(value, 30);
+	EXPECT_FALSE(scan.next(value));
+	EXPECT_EQ(value, 30);
+	scan.next_line();
+	EXPECT_EQ(scan.field(), "intr"sv);
+	scan.next_line();
+	scan.next_line();
+	EXPECT_TRUE(scan.empty());
+}
+
+TEST(procfs, parse_pid_stat) {
+	constexpr auto stat = "1234 (tmux: server) S 1 1234 1234 0 -1 4194624 1551 0 0 0 "
+						  "153 72 0 0 20 -5 3 0 4217 12345678 2048 18446744073709551615\n"sv;
+	const auto parsed = Procfs::parse_pid_stat(stat);
+	ASSERT_TRUE(parsed.has_value());
+	EXPECT_EQ(parsed->state, 'S');
+	EXPECT_EQ(parsed->ppid, 1);
+	EXPECT_EQ(parsed->utime, 153);
+	EXPECT_EQ(parsed->stime, 72);
+	EXPECT_EQ(parsed->nice, -5);
+	EXPECT_EQ(parsed->threads, 3);
+	EXPECT_EQ(parsed->starttime, 4217);
+	EXPECT_EQ(parsed->rss, 2048);
+
+	//? Names can contain parentheses and spaces
+	const auto odd_name = Procfs::parse_pid_stat("7 (a) b (c)) R 2 0 0 0 0 0 0 0 0 0 1 2 0 0 0 0 1 0 9 0 4\n"sv);
+	ASSERT_TRUE(odd_name.has_value());
+	EXPECT_EQ(odd_name->state, 'R');
+	EXPECT_EQ(odd_name->ppid, 2);
+	EXPECT_EQ(odd_name->rss, 4);
+
+	EXPECT_FALSE(Procfs::parse_pid_stat(""sv).has_value());
+	EXPECT_FALSE(Procfs::parse_pid_stat("1234 (truncated) S 1 1234 1234 0"sv).has_value());
+}
+
+TEST(procfs, parse_status_uid) {
+	constexpr auto status = "Name:\tbash\nUmask:\t0022\nState:\tS (sleeping)\nUid:\t1000\t1000\t1000\t1000\nGid:\t100\n"sv;
+	EXPECT_EQ(Procfs::parse_status_uid(status), 1000);
+	EXPECT_EQ(Procfs::parse_status_uid("Name:\tbash\n"sv), std::nullopt);
+	EXPECT_EQ(Procfs::parse_status_uid("Uid:\tbad\n"sv), std::nullopt);
+}
+
+//? Build a /proc/stat snapshot with <cores> cores where core N has N in every field
+static auto make_stat(int cores) -> std::string {
+	std::string out = "cpu  1 2 3 4 5 6 7 8 9 10\n";
+	for (int i = 0; i < cores; i++) {
+		const auto n = std::to_string(i);
+		out += "cpu" + n;
+		for (int field = 0; field < 10; field++) out += ' ' + n;
+		out += '\n';
+	}
+	out += "intr 1 2 3\nctxt 4\n";
+	return out;
+}
+
+TEST(procfs, parse_cpu_stat) {
+	for (const int cores : { 8, 64, 512 }) {
+		const auto snapshot = make_stat(cores);
+		Procfs::Scanner scan { snapshot };
+
+		const auto all = Procfs::parse_cpu_stat(scan);
+		ASSERT_TRUE(all.has_value());
+		EXPECT_EQ(all->core, -1);
+		EXPECT_EQ(all->count, 10);
+		EXPECT_EQ(all->times[Procfs::cpu_stat::guest_nice], 10);
+		EXPECT_EQ(all->total(), 36);
+		EXPECT_EQ(all->idle_total(), 9);
+
+		int count = 0;
+		for (auto line = Procfs::parse_cpu_stat(scan); line.has_value(); line = Procfs::parse_cpu_stat(scan), count++) {
+			EXPECT_EQ(line->core, count);
+			EXPECT_EQ(line->total(), 8ull * count);
+		}
+		EXPECT_EQ(count, cores);
+		EXPECT_TRUE(scan.rest().starts_with("intr"));
+	}
+
+	//? Old kernels have only four fields and future kernels may add more
+	Procfs::Scanner old_kernel { "cpu0 1 2 3 4\n"sv };
+	const auto short_line = Procfs::parse_cpu_stat(old_kernel);
+	ASSERT_TRUE(short_line.has_value());
+	EXPECT_EQ(short_line->count, 4);
+	EXPECT_EQ(short_line->idle_total(), 4);
+	EXPECT_TRUE(old_kernel.empty());
+
+	Procfs::Scanner new_kernel { "cpu3 1 1 1 1 1 1 1 1 1 1 1 1\nintr 0\n"sv };
+	const auto long_line = Procfs::parse_cpu_stat(new_kernel);
+	ASSERT_TRUE(long_line.has_value());
+	EXPECT_EQ(long_line->core, 3);
+	EXPECT_EQ(long_line->total(), 8);
+	EXPECT_EQ(new_kernel.rest(), "intr 0\n"sv);
+
+	Procfs::Scanner malformed { "cpu1 1 2\n"sv };
+	EXPECT_FALSE(Procfs::parse_cpu_stat(malformed).has_value());
+	EXPECT_EQ(malformed.rest(), "cpu1 1 2\n"sv);
+}
+
+TEST(procfs, parse_meminfo) {
+	using Procfs::meminfo_stat;
+
+	//? Captured from a 6.x kernel with huge pages reserved, fields between the ones parsed are trimmed
+	constexpr auto current = "MemTotal:       32598716 kB\nMemFree:         9413236 kB\nMemAvailable:   24117172 kB\n"
+							 "Buffers:          812344 kB\nCached:         13498160 kB\nSwapCached:            0 kB\n"
+							 "SwapTotal:       8388604 kB\nSwapFree:        8388604 kB\nZswap:                 0 kB\n"
+							 "Dirty:              1320 kB\nWriteback:             0 kB\nAnonPages:       6843204 kB\n"
+							 "Shmem:            624916 kB\nKReclaimable:    1118312 kB\nSlab:            1544908 kB\n"
+							 "CommitLimit:    24687960 kB\nCommitted_AS:   19207276 kB\nVmallocTotal:   34359738367 kB\n"
+							 "HugePages_Total:     512\nHugePages_Free:      384\nHugePages_Rsvd:        0\n"
+							 "Hugepagesize:       2048 kB\nHugetlb:         1048576 kB\nDirectMap4k:      698044 kB\n"sv;
+	const auto info = Procfs::parse_meminfo(current);
+	EXPECT_EQ(info.found, (1u << meminfo_stat::field_count) - 1);
+	EXPECT_EQ(info[meminfo_stat::mem_total], 32598716ull << 10);
+	EXPECT_EQ(info[meminfo_stat::mem_available], 24117172ull << 10);
+	EXPECT_EQ(info[meminfo_stat::cached], 13498160ull << 10);
+	EXPECT_EQ(info[meminfo_stat::swap_free], 8388604ull << 10);
+	EXPECT_EQ(info[meminfo_stat::dirty], 1320ull << 10);
+	EXPECT_EQ(info[meminfo_stat::writeback], 0);
+	EXPECT_EQ(info[meminfo_stat::slab], 1544908ull << 10);
+	EXPECT_EQ(info[meminfo_stat::committed_as], 19207276ull << 10);
+	EXPECT_EQ(info[meminfo_stat::hugepages_total], 512);
+	EXPECT_EQ(info[meminfo_stat::hugepages_free], 384);
+	EXPECT_EQ(info[meminfo_stat::hugepage_size], 2048ull << 10);
+
+	//? Captured from a 2.6.32 kernel, which predates MemAvailable and has no swap configured
+	constexpr auto old_kernel = "MemTotal:        1922680 kB\nMemFree:          151964 kB\nBuffers:          162644 kB\n"
+								"Cached:          1190620 kB\nSwapCached:            0 kB\nActive:           944256 kB\n"
+								"SwapTotal:             0 kB\nSwapFree:              0 kB\nDirty:                72 kB\n"
+								"Writeback:             0 kB\nAnonPages:        265552 kB\nShmem:               224 kB\n"
+								"Slab:             104528 kB\nCommitLimit:      961340 kB\nCommitted_AS:     552396 kB\n"sv;
+	const auto old_info = Procfs::parse_meminfo(old_kernel);
+	EXPECT_FALSE(old_info.has(meminfo_stat::mem_available));
+	EXPECT_FALSE(old_info.has(meminfo_stat::hugepages_total));
+	EXPECT_TRUE(old_info.has(meminfo_stat::swap_total));
+	EXPECT_EQ(old_info[meminfo_stat::mem_free], 151964ull << 10);
+	EXPECT_EQ(old_info[meminfo_stat::committed_as], 552396ull << 10);
+
+	//? Lines without a colon or a number are skipped, labels must match exactly
+	const auto malformed = Procfs::parse_meminfo("MemTotal 100 kB\nMemFree:  bad kB\nMemFreeX:  5 kB\nCached:\nSlab:  7 kB"sv);
+	EXPECT_EQ(malformed.found, 1u << meminfo_stat::slab);
+	EXPECT_EQ(malformed[meminfo_stat::slab], 7ull << 10);
+
+	static_assert(Procfs::meminfo_field("HugePages_Total") == meminfo_stat::hugepages_total);
+	static_assert(Procfs::meminfo_field("Active(file)") == meminfo_stat::field_count);
+}
+
+TEST(procfs, disk_stats) {
+	//? Lines of older kernels without discard and flush counters, and of newer ones with them
+	std::string table = "   8       0 sda 1 2 3 4 5 6 7 8 9 10 11\n"
+						"   8       1 sda1 12 0 24 0 36 0 48 0 0 60 72 0 0 0 0 1 2\n"
+						" 253       0 dm-0 1 2 3\n";
+	for (int i = 0; i < 1000; i++)
+		table += fmt::format("{:4} {:7} dev{} {} 0 {} 0 {} 0 {} 0 0 {} {} 0 0 0 0 0 0\n", 259, i, i, i, i * 8, i * 2, i * 16, i, i * 3);
+
+	Procfs::DiskStats stats;
+	stats.parse(table);
+	ASSERT_EQ(stats.size(), 1003);
+
+	size_t hint = 0;
+	const auto sda = stats.find("sda", hint);
+	ASSERT_TRUE(sda.has_value());
+	EXPECT_EQ(sda->values[Procfs::disk_stat::reads], 1);
+	EXPECT_EQ(sda->values[Procfs::disk_stat::queue_ms], 11);
+
+	const auto part = stats.find("sda1", hint);
+	ASSERT_TRUE(part.has_value());
+	EXPECT_EQ(hint, 1);
+	EXPECT_EQ(part->values[Procfs::disk_stat::sectors_read], 24);
+	EXPECT_EQ(part->values[Procfs::disk_stat::sectors_written], 48);
+	EXPECT_EQ(part->values[Procfs::disk_stat::io_ms], 60);
+
+	//? Truncated lines have no counters
+	EXPECT_EQ(stats.find("dm-0", hint), std::nullopt);
+	EXPECT_EQ(stats.find("missing", hint), std::nullopt);
+
+	const auto last = stats.find("dev999", hint);
+	ASSERT_TRUE(last.has_value());
+	EXPECT_EQ(hint, 1002);
+	EXPECT_EQ(last->values[Procfs::disk_stat::writes], 999 * 2);
+	EXPECT_EQ(stats.find("dev999", hint)->values, last->values);
+
+	//? A stat file in /sys/block has the same counters without the device numbers and name
+	Procfs::Scanner scan { "    1     2     3     4     5     6     7     8     9    10    11\n"sv };
+	const auto file = Procfs::parse_disk_stat(scan);
+	ASSERT_TRUE(file.has_value());
+	EXPECT_EQ(file->values[Procfs::disk_stat::write_ms], 8);
+	EXPECT_TRUE(scan.empty());
+}
+
+TEST(procfs, parse_mounts) {
+	constexpr auto table = "/dev/sda1 / ext4 rw,relatime 0 0\n"
+						   "/dev/sdb1 /mnt/my\\040disk\\134x vfat rw 0 0\n"
+						   "broken line\n"
+						   "tmpfs /run\\04 tmpfs rw 0 0\n"sv;
+	const auto mounts = Procfs::parse_mounts(table);
+	ASSERT_EQ(mounts.size(), 3);
+	EXPECT_EQ(mounts[0].dev, "/dev/sda1");
+	EXPECT_EQ(mounts[0].mountpoint, "/");
+	EXPECT_EQ(mounts[0].fstype, "ext4");
+	EXPECT_EQ(mounts[1].mountpoint, "/mnt/my disk\\x");
+	EXPECT_EQ(mounts[1].fstype, "vfat");
+	//? Incomplete escapes are kept as they are
+	EXPECT_EQ(mounts[2].mountpoint, "/run\\04");
+}
+
+TEST(procfs, mount_table) {
+	//? A regular file isn't watched and is read again on every update
+	std::array<char, 64> path_template { "/tmp/btop_mounts_XXXXXX" };
+	const int fd = mkstemp(path_template.data());
+	ASSERT_GE(fd, 0);
+	constexpr auto line = "/dev/sda1 / ext4 rw 0 0\n"sv;
+	ASSERT_EQ(write(fd, line.data(), line.size()), static_cast<ssize_t>(line.size()));
+	close(fd);
+
+	Procfs::MountTable file;
+	ASSERT_TRUE(file.open(path_template.data(), false));
+	EXPECT_TRUE(file.update());
+	EXPECT_TRUE(file.update());
+	ASSERT_EQ(file.mounts().size(), 1);
+	EXPECT_EQ(file.mounts()[0].mountpoint, "/");
+	unlink(path_template.data());
+
+	//? The mount table of the process is read once and then only when the kernel reports a change
+	Procfs::MountTable mounts;
+	ASSERT_TRUE(mounts.open("/proc/self/mounts", true));
+	EXPECT_TRUE(mounts.update());
+	EXPECT_FALSE(mounts.mounts().empty());
+	EXPECT_FALSE(mounts.update());
+
+	Procfs::MountTable missing;
+	EXPECT_FALSE(missing.open("/nonexistent/btop/mounts", true));
+	EXPECT_THROW(missing.update(), std::runtime_error);
+}
+
+TEST(procfs, read_at) {
+	std::array<char, 64> path_template { "/tmp/btop_procfs_XXXXXX" };
+	const int fd = mkstemp(path_template.data());
+	ASSERT_GE(fd, 0);
+	constexpr auto content = "1 2 3\n"sv;
+	ASSERT_EQ(write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+	close(fd);
+
+	std::array<char, 4> small;
+	const auto truncated = Procfs::read_at(AT_FDCWD, path_template.data(), small);
+	ASSERT_TRUE(truncated.has_value());
+	EXPECT_EQ(*truncated, "1 2 "sv);
+
+	std::array<char, 64> buf;
+	const auto full = Procfs::read_at(AT_FDCWD, path_template.data(), buf);
+	ASSERT_TRUE(full.has_value());
+	EXPECT_EQ(*full, content);
+
+	unlink(path_template.data());
+	EXPECT_FALSE(Procfs::read_at(AT_FDCWD, path_template.data(), buf).has_value());
+}
+
+TEST(procfs, uring_reader) {
+	Procfs::UringReader reader;
+	if (not reader.init(4)) GTEST_SKIP() << "io_uring not available";
+
+	//? More files than ring entries to cover several batches, and one missing file
+	std::vector<std::string> paths;
+	for (int i = 0; i < 10; i++) {
+		std::array<char, 64> path_template { "/tmp/btop_uring_XXXXXX" };
+		const int fd = mkstemp(path_template.data());
+		ASSERT_GE(fd, 0);
+		const auto content = std::to_string(i * 1000);
+		ASSERT_EQ(write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+		close(fd);
+		paths.emplace_back(path_template.data());
+	}
+	paths.emplace_back("/tmp/btop_uring_missing");
+
+	std::vector<std::array<char, 16>> buffers(paths.size());
+	std::vector<Procfs::batch_read> reads;
+	for (size_t i = 0; i < paths.size(); i++) reads.push_back({ paths[i].c_str(), buffers[i] });
+
+	ASSERT_TRUE(reader.read(AT_FDCWD, reads));
+	for (int i = 0; i < 10; i++) {
+		ASSERT_GT(reads[i].result, 0);
+		EXPECT_EQ(std::string_view(buffers[i].data(), reads[i].result), std::to_string(i * 1000));
+	}
+	EXPECT_EQ(reads.back().result, -ENOENT);
+
+	for (int i = 0; i < 10; i++) unlink(paths[i].c_str());
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "btop_screen.hpp"
+
+TEST(screen, first_flush_clears_and_draws) {
+	Screen::Buffer screen;
+	screen.write("ignored");
+	EXPECT_EQ(screen.flush(), "");
+
+	screen.reset(10, 3);
+	ASSERT_TRUE(screen.ready(10, 3));
+	EXPECT_FALSE(screen.ready(11, 3));
+	screen.write("\x1b[2;3fab");
+	EXPECT_EQ(screen.flush(), "\x1b[0m\x1b[2J\x1b[2;3Hab");
+}
+
+TEST(screen, unchanged_frames_are_skipped) {
+	Screen::Buffer screen;
+	screen.reset(10, 3);
+	screen.write("\x1b[1;1f\x1b[31mhello\x1b[0m");
+	screen.flush();
+
+	screen.write("\x1b[1;1f\x1b[31mhello\x1b[0m");
+	EXPECT_EQ(screen.flush(), "");
+
+	//? Only the changed cell is sent, starting from an unknown style
+	screen.write("\x1b[1;1f\x1b[31mhallo\x1b[0m");
+	EXPECT_EQ(screen.flush(), "\x1b[1;2H\x1b[0;31ma");
+}
+
+TEST(screen, cursor_moves_and_gaps) {
+	Screen::Buffer screen;
+	screen.reset(20, 2);
+	screen.write("abcdefghij");
+	screen.flush();
+
+	//? Short unchanged gaps are rewritten, longer ones are skipped with a cursor move
+	screen.write("\x1b[1;1fX\x1b[1CY\x1b[5CZ");
+	EXPECT_EQ(screen.flush(), "\x1b[1;1H\x1b[0mXbY\x1b[5CZ");
+
+	screen.write("\x1b[2;5f12\x1b[1D\x1b[1A3");
+	EXPECT_EQ(screen.flush(), "\x1b[1;6H\x1b[0m3\x1b[2;5H12");
+}
+
+TEST(screen, styles) {
+	Screen::Buffer screen;
+	screen.reset(10, 1);
+	screen.write("\x1b[1;38;2;10;20;30ma\x1b[22;48;5;100mb\x1b[0;2;94mc");
+	EXPECT_EQ(screen.flush(), "\x1b[0m\x1b[2J\x1b[1;1H\x1b[1;38;2;10;20;30ma\x1b[22;48;5;100mb\x1b[2;94;49mc");
+
+	//? Turning off one of bold and dim turns the other one back on
+	screen.write("\x1b[1;1f\x1b[0;1;2mab\x1b[22;1mc");
+	EXPECT_EQ(screen.flush(), "\x1b[1;1H\x1b[0;1;2mab\x1b[22;1mc");
+}
+
+TEST(screen, wide_characters_and_erase) {
+	Screen::Buffer screen;
+	screen.reset(6, 2);
+	screen.write("\x1b[1;1f中x");
+	EXPECT_EQ(screen.flush(), "\x1b[0m\x1b[2J\x1b[1;1H中x");
+
+	//? Overwriting the right half of a double width character blanks the left half
+	screen.write("\x1b[1;2fy");
+	EXPECT_EQ(screen.flush(), "\x1b[1;1H\x1b[0m y");
+
+	screen.write("\x1b[2J");
+	EXPECT_EQ(screen.flush(), "\x1b[1;2H\x1b[0m  ");
+	screen.write("\x1b[?25l\x1b[1;1f");
+	EXPECT_EQ(screen.flush(), "\x1b[?25l");
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "btop_statvfs.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+	//? Polls take() until a result comes in or a second has passed
+	auto wait_result(Statvfs::Pool& pool, const std::string& mountpoint) -> std::optional<Statvfs::result> {
+		for (int i = 0; i < 200; i++) {
+			if (auto res = pool.take(mountpoint)) return res;
+			std::this_thread::sleep_for(5ms);
+		}
+		return std::nullopt;
+	}
+}
+
+TEST(statvfs, query) {
+	const auto root = Statvfs::query("/");
+	EXPECT_EQ(root.error, 0);
+	EXPECT_GT(root.total, 0u);
+	EXPECT_LE(root.avail, root.free);
+	EXPECT_NE(Statvfs::query("/nonexistent/btop/mount").error, 0);
+}
+
+TEST(statvfs, pool_results) {
+	Statvfs::Pool pool {2, 1'000, 1'000, 1'000};
+	EXPECT_EQ(pool.take("/"), std::nullopt);
+	pool.request("/");
+	const auto res = wait_result(pool, "/");
+	ASSERT_TRUE(res.has_value());
+	EXPECT_EQ(res->error, 0);
+	//? A result is only returned once
+	EXPECT_EQ(pool.take("/"), std::nullopt);
+}
+
+TEST(statvfs, pool_timeout) {
+	std::atomic<bool> release;
+	std::atomic<int> calls;
+	Statvfs::Pool pool {1, 20, 60'000, 60'000, [&](const std::string& mountpoint) {
+		calls++;
+		while (mountpoint == "/hung" and not release) std::this_thread::sleep_for(1ms);
+		return Statvfs::result { .total = 100 };
+	}};
+
+	pool.request("/hung");
+	std::this_thread::sleep_for(50ms);
+	pool.expire();
+	EXPECT_EQ(pool.timed_out(), 1u);
+
+	//? The only worker is stuck, a replacement serves the other mountpoints
+	pool.request("/ok");
+	ASSERT_TRUE(wait_result(pool, "/ok").has_value());
+	EXPECT_EQ(pool.queued(), 0u);
+
+	//? A mountpoint that timed out isn't requested again until its back-off has passed
+	release = true;
+	ASSERT_TRUE(wait_result(pool, "/hung").has_value());
+	pool.request("/hung");
+	EXPECT_EQ(pool.queued(), 0u);
+	EXPECT_EQ(calls, 2);
+	EXPECT_EQ(pool.timed_out(), 1u);
+}
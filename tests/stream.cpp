@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "btop_stream.hpp"
+
+namespace {
+	auto sample_cpu() -> Cpu::cpu_info {
+		Cpu::cpu_info cpu;
+		cpu.cpu_percent.at("total").push_back(42);
+		cpu.core_percent = { {10}, {90} };
+		cpu.load_avg = { 1.5, 0.5, 0.0 };
+		return cpu;
+	}
+
+	auto sample_procs() -> std::vector<Proc::proc_info> {
+		std::vector<Proc::proc_info> procs(3);
+		procs[0].pid = 1;
+		procs[0].name = "init";
+		procs[0].cmd = "/sbin/init \"splash\"";
+		procs[0].user = "root";
+		procs[0].cpu_p = 12.34;
+		procs[0].mem = 4096;
+		procs[0].threads = 1;
+		procs[1].pid = 2;
+		procs[1].filtered = true;
+		procs[2].pid = 3;
+		procs[2].name = "a,b";
+		procs[2].cmd = "tab\there";
+		procs[2].user = "user";
+		procs[2].threads = 2;
+		return procs;
+	}
+}
+
+TEST(stream, json_lines) {
+	Stream::Writer writer { Stream::Format::json };
+	EXPECT_EQ(writer.header(1, 2), "");
+
+	writer.begin(1000);
+	writer.cpu(sample_cpu());
+	writer.procs(sample_procs(), 2);
+	EXPECT_EQ(writer.end(),
+		R"({"time":1000,"cpu":{"total":42,"cores":[10,90],"load_1m":1.5,"load_5m":0.5,"load_15m":0.0,"temp":null},)"
+		R"("procs":[{"pid":1,"name":"init","cmd":"/sbin/init \"splash\"","user":"root","cpu":12.3,"mem":4096,"threads":1},)"
+		R"({"pid":3,"name":"a,b","cmd":"tab\u0009here","user":"user","cpu":0.0,"mem":0,"threads":2}]})" "\n");
+
+	//? The buffer is reused, a new sample replaces the previous one
+	writer.begin(2000);
+	writer.procs({}, 2);
+	EXPECT_EQ(writer.end(), "{\"time\":2000,\"procs\":[]}\n");
+}
+
+TEST(stream, csv_rows) {
+	Stream::Writer writer { Stream::Format::csv };
+	EXPECT_EQ(writer.header(0, 2),
+		"time,cpu,load_1m,load_5m,load_15m,cpu_temp,"
+		"mem_total,mem_used,mem_available,mem_cached,mem_free,swap_total,swap_used,"
+		"net_iface,net_download,net_upload,net_download_total,net_upload_total,"
+		"proc0_pid,proc0_name,proc0_user,proc0_cpu,proc0_mem,proc1_pid,proc1_name,proc1_user,proc1_cpu,proc1_mem\n");
+
+	writer.begin(1000);
+	writer.cpu(sample_cpu());
+	writer.procs(sample_procs(), 3);
+	EXPECT_EQ(writer.end(), "1000,42,1.5,0.5,0.0,,1,init,root,12.3,4096,3,\"a,b\",user,0.0,0,,,,,\n");
+}
@@ -1,9 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "btop_history.hpp"
+#include "btop_ringbuffer.hpp"
 #include "btop_tools.hpp"
 
 TEST(tools, string_split) {
@@ -21,3 +28,95 @@ TEST(tools, string_split) {
 		EXPECT_EQ(actual, expected);
 	}
 }
+
+TEST(tools, thread_pool_parallel_for) {
+	Tools::ThreadPool pool(3);
+	EXPECT_EQ(pool.size(), 3);
+
+	std::vector<int> hits(1000);
+	pool.parallel_for(hits.size(), [&](size_t i) { hits[i]++; });
+	EXPECT_EQ(std::ranges::count(hits, 1), 1000);
+
+	pool.parallel_for(0, [](size_t) { FAIL(); });
+
+	std::atomic<int> calls{};
+	EXPECT_THROW(pool.parallel_for(100, [&](size_t i) {
+		calls++;
+		if (i == 10) throw std::runtime_error("fail");
+	}), std::runtime_error);
+	EXPECT_LE(calls, 100);
+
+	//? A thread limit of one runs every call on the calling thread
+	const auto caller = std::this_thread::get_id();
+	pool.parallel_for(100, [&](size_t) { EXPECT_EQ(std::this_thread::get_id(), caller); }, 1);
+
+	pool.resize(0);
+	EXPECT_EQ(pool.size(), 0);
+	pool.parallel_for(hits.size(), [&](size_t i) { hits[i]++; });
+	EXPECT_EQ(std::ranges::count(hits, 2), 1000);
+}
+
+TEST(tools, ring_buffer) {
+	Tools::RingBuffer<uint8_t> ring;
+	EXPECT_TRUE(ring.empty());
+
+	//? Trim to 10 values the same way the collectors do, so the storage wraps around several times
+	for (long long i = 0; i < 100; i++) {
+		ring.push_back(i);
+		while (ring.size() > 10) ring.pop_front();
+	}
+	EXPECT_EQ(ring.size(), 10);
+	EXPECT_EQ(ring.capacity(), 16);
+	EXPECT_EQ(ring.front(), 90);
+	EXPECT_EQ(ring.back(), 99);
+	EXPECT_EQ(ring.at(3), 93);
+	EXPECT_THROW((void)ring.at(10), std::out_of_range);
+	EXPECT_EQ(std::accumulate(ring.begin(), ring.end(), 0ll), 945);
+	EXPECT_EQ(std::accumulate(ring.rbegin(), ring.rbegin() + 5, 0ll), 485);
+	EXPECT_EQ(ring.end() - ring.begin(), 10);
+
+	//? Values outside the storage type are saturated
+	ring.push_back(-5);
+	ring.push_back(300);
+	EXPECT_EQ(ring[ring.size() - 2], 0);
+	EXPECT_EQ(ring.back(), 255);
+
+	Tools::RingBuffer<long long> wide { 1, 1ll << 40 };
+	EXPECT_EQ(wide.size(), 2);
+	EXPECT_EQ(wide.back(), 1ll << 40);
+
+	ring.clear();
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST(tools, tiered_history) {
+	using History = Tools::TieredHistory<uint8_t>;
+	using enum History::consolidation;
+	History history;
+
+	//? One sample every 2 seconds for a minute, then a 30 second gap
+	unsigned advanced = 0;
+	for (uint64_t ms = 0; ms < 60'000; ms += 2'000) advanced |= history.add(ms, ms / 1'000);
+	EXPECT_EQ(advanced, 1u);
+	EXPECT_NE(history.add(90'000, 100) & 2u, 0u);
+
+	//? Steps 0-50 of the 10s tier are complete, followed by three gap steps for 60-80
+	const auto& avg_series = history.series(0, avg);
+	ASSERT_EQ(avg_series.size(), 9);
+	EXPECT_EQ(avg_series.front(), 4);
+	EXPECT_EQ(history.series(0, min).front(), 0);
+	EXPECT_EQ(history.series(0, max).front(), 8);
+	EXPECT_EQ(avg_series[5], 54);
+	EXPECT_EQ(avg_series[6], Tools::history_gap<uint8_t>);
+	EXPECT_EQ(avg_series[8], Tools::history_gap<uint8_t>);
+	EXPECT_EQ(history.series(0, max)[7], Tools::history_gap<uint8_t>);
+
+	const auto& minute = history.series(1, max);
+	ASSERT_EQ(minute.size(), 1);
+	EXPECT_EQ(minute.back(), 58);
+
+	//? Memory stays bounded by the number of steps per tier
+	for (uint64_t step = 0; step < 2 * History::tier_slots; step++) history.add(100'000 + step * 10'000, 50);
+	EXPECT_EQ(history.series(0, avg).size(), History::tier_slots);
+	EXPECT_EQ(history.series(0, avg).capacity(), History::tier_slots);
+}